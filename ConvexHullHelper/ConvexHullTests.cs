@@ -142,6 +142,35 @@ namespace ConvexHullHelper
 			_referenceResults = new Point[] { new Point(2, 0), new Point(-1, 0), new Point(-1, -1) };
 			if (Test() == ExecutionState.Stop) return ExecutionState.Stop;
 
+			// Many points as far from the other side (ties), more than one chunk of the parallel engines. Vertices
+			// come last: the first point found on a side is not one of its ends.
+			LatestTestName = "Trapezoid, 100000 points, every 10th on one of the 2 parallel sides";
+			_points = new Point[100000];
+			Random random = new Random(1);
+			for (int index = 0; index < _points.Length - 4; index++)
+			{
+				if (index % 20 == 0)
+				{
+					_points[index] = new Point(0.5 + 9 * random.NextDouble(), 0);
+				}
+				else if (index % 10 == 0)
+				{
+					_points[index] = new Point(3.25 + 3.5 * random.NextDouble(), 5);
+				}
+				else
+				{
+					double y = 0.1 + 4.8 * random.NextDouble();
+					double left = 0.6 * y + 0.01;
+					_points[index] = new Point(left + (10 - 2 * left) * random.NextDouble(), y);
+				}
+			}
+			_points[_points.Length - 4] = new Point(0, 0);
+			_points[_points.Length - 3] = new Point(10, 0);
+			_points[_points.Length - 2] = new Point(7, 5);
+			_points[_points.Length - 1] = new Point(3, 5);
+			_referenceResults = new Point[] { new Point(10, 0), new Point(7, 5), new Point(3, 5), new Point(0, 0) };
+			if (Test() == ExecutionState.Stop) return ExecutionState.Stop;
+
 			return ExecutionState.Continue;
 		}
 
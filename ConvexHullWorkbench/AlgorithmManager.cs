@@ -78,6 +78,24 @@ namespace ConvexHullWorkbench
 
 			AlgoIndexHeap = _algorithms.Count - 1;
 
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Heap MT", "?, Pat Morin, Eric Ouellet",
+				"Heap with a parallel partition, upper and lower hulls on their own thread.", OxyPlot.OxyColors.Plum,
+				(points, algorithmStat) =>
+				{
+					ConvexHullHeapAndChanWrapper wrapper = new ConvexHullHeapAndChanWrapper(points);
+					wrapper.HeapHullParallel();
+					var result = wrapper.HullPoints;
+
+					if (algorithmStat != null)
+					{
+						algorithmStat.TimeSpanOriginal = wrapper.TimeSpan;
+					}
+
+					return result;
+				}));
+
+			AlgoIndexHeapParallel = _algorithms.Count - 1;
+
 			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "MI ConvexHUll (Delaunay/Voronoi)", "Delaunay and Voronoi, davecz",
 				"Slow. From CodePlex. Could do 3D.", OxyPlot.OxyColors.Indigo,
 				(points, algorithmStat) =>
@@ -119,7 +137,7 @@ namespace ConvexHullWorkbench
 
 			AlgoIndexMiConvexHull = _algorithms.Count - 1;
 
-			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Chan", "Chan, Pat Morin", "C code. Has a little bug (happen rarely). Got on the web.",
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Chan", "Chan, Pat Morin", "C code. Got on the web, median slope selection completed. O(n log h).",
 				OxyPlot.OxyColors.Red,
 				(points, algorithmStat) =>
 				{
@@ -147,6 +165,34 @@ namespace ConvexHullWorkbench
 
 			AlgoIndexChan = _algorithms.Count - 1;
 
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Chan MT", "Chan, Pat Morin, Eric Ouellet",
+				"Chan with its groups computed in parallel. O(n log h).", OxyPlot.OxyColors.DarkRed,
+				(points, algorithmStat) =>
+				{
+					Point[] result = null;
+					try
+					{
+						ConvexHullHeapAndChanWrapper wrapper = new ConvexHullHeapAndChanWrapper(points);
+						wrapper.ChanHullParallel();
+						result = wrapper.HullPoints;
+
+						if (algorithmStat != null)
+						{
+							algorithmStat.TimeSpanOriginal = wrapper.TimeSpan;
+						}
+
+					}
+					catch (Exception ex)
+					{
+						Console.WriteLine(ex.ToString());
+						Debugger.Break();
+					}
+
+					return result;
+				}));
+
+			AlgoIndexChanParallel = _algorithms.Count - 1;
+
 			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "LiuAndChen", "Liu and Chen, Eric Ouellet", "The same as Ouellet without my optimization",
 				OxyPlot.OxyColors.LightSkyBlue,
 				(points, algorithmStat) =>
@@ -327,6 +373,84 @@ namespace ConvexHullWorkbench
 				}));
 
 			AlgoIndexOuelletConvexHullCpp = _algorithms.Count - 1;
+
+			// Task parallel baselines of OuelletConvexHullCpp: engine 0 is ParallelHullQuick, 1 is ParallelHullDivideAndConquer
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "QuickHull CPP MT", "Eddy, Eric Ouellet", "Task parallel, one thread per core.",
+				OxyPlot.OxyColors.DarkOrange,
+				(points, algorithmStat) =>
+				{
+					double elapsedTime = 0;
+
+					OuelletConvexHullCpp convexHull = new OuelletConvexHullCpp();
+					var result = convexHull.ParallelHullManagedWithElapsedTime(0, points, true, ref elapsedTime);
+
+					if (algorithmStat != null)
+					{
+						algorithmStat.TimeSpanOriginal = TimeSpanHelper.MoreAccurateTimeSpanFromSeconds(elapsedTime);
+					}
+
+					return result;
+				}));
+
+			AlgoIndexQuickHullCpp = _algorithms.Count - 1;
+
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Divide and conquer CPP MT", "Preparata and Hong, Eric Ouellet",
+				"Task parallel, one thread per core.", OxyPlot.OxyColors.Teal,
+				(points, algorithmStat) =>
+				{
+					double elapsedTime = 0;
+
+					OuelletConvexHullCpp convexHull = new OuelletConvexHullCpp();
+					var result = convexHull.ParallelHullManagedWithElapsedTime(1, points, true, ref elapsedTime);
+
+					if (algorithmStat != null)
+					{
+						algorithmStat.TimeSpanOriginal = TimeSpanHelper.MoreAccurateTimeSpanFromSeconds(elapsedTime);
+					}
+
+					return result;
+				}));
+
+			AlgoIndexDivideAndConquerCpp = _algorithms.Count - 1;
+
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Monotone chain CPP", "A. M. Andrew, Eric Ouellet",
+				"Parallel radix sort, then monotone chain. O(n).", OxyPlot.OxyColors.SlateBlue,
+				(points, algorithmStat) =>
+				{
+					double elapsedTime = 0;
+
+					OuelletConvexHullCpp convexHull = new OuelletConvexHullCpp();
+					var result = convexHull.MonotoneChainHullManagedWithElapsedTime(points, true, ref elapsedTime);
+
+					if (algorithmStat != null)
+					{
+						algorithmStat.TimeSpanOriginal = TimeSpanHelper.MoreAccurateTimeSpanFromSeconds(elapsedTime);
+					}
+
+					return result;
+				}));
+
+			AlgoIndexMonotoneChainCpp = _algorithms.Count - 1;
+
+			_algorithms.Add(new AlgorithmStandard(AlgorithmType.ConvexHull, "Auto CPP", "Eric Ouellet",
+				"Engine chosen from a sample of the points and a cost model.", OxyPlot.OxyColors.Olive,
+				(points, algorithmStat) =>
+				{
+					double elapsedTime = 0;
+					int engine = 0;
+
+					OuelletConvexHullCpp convexHull = new OuelletConvexHullCpp();
+					var result = convexHull.AutoHullManagedWithElapsedTime(points, true, ref elapsedTime, ref engine);
+
+					if (algorithmStat != null)
+					{
+						algorithmStat.TimeSpanOriginal = TimeSpanHelper.MoreAccurateTimeSpanFromSeconds(elapsedTime);
+					}
+
+					return result;
+				}));
+
+			AlgoIndexAutoHullCpp = _algorithms.Count - 1;
 			
 			// Color r = Colors.CornflowerBlue;
 			_algorithms.Add(new AlgorithmOnline(AlgorithmType.ConvexHullOnline, "Ouellet C# Avl v3 (** Only for Online performance test)", "Eric Ouellet, Eric Ouellet",
@@ -422,7 +546,9 @@ namespace ConvexHullWorkbench
 
 		public int AlgoIndexMonotoneChain { get; private set; }
 		public int AlgoIndexChan { get; private set; }
+		public int AlgoIndexChanParallel { get; private set; }
 		public int AlgoIndexHeap { get; private set; }
+		public int AlgoIndexHeapParallel { get; private set; }
 		public int AlgoIndexLiuAndChen { get; private set; }
 		public int AlgoIndexOuelletConvexHullSingleThread { get; private set; }
 		public int AlgoIndexOuelletConvexHullSingleThreadArray { get; private set; }
@@ -436,6 +562,10 @@ namespace ConvexHullWorkbench
 		public int AlgoIndexOuelletConvexHull4Threads { get; private set; }
 		public int AlgoIndexOuelletConvexHullMultiThreads { get; private set; }
 		public int AlgoIndexOuelletConvexHullCpp { get; private set; }
+		public int AlgoIndexQuickHullCpp { get; private set; }
+		public int AlgoIndexDivideAndConquerCpp { get; private set; }
+		public int AlgoIndexMonotoneChainCpp { get; private set; }
+		public int AlgoIndexAutoHullCpp { get; private set; }
 		public int AlgoIndexMiConvexHull { get; private set; }
 
 		public int AlgoIndexOuelletConvexHullAvl2OnlineWithOnlineInterface { get; private set; }
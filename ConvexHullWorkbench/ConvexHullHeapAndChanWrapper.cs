@@ -46,12 +46,18 @@ namespace ConvexHullWorkbench
 		[DllImport("PatMorinImplementationOfChanAndHeap.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern int heaphull2WithElapsedTime([In, Out] Point[] s, int n, ref double elapsedTime);
 
+		[DllImport("PatMorinImplementationOfChanAndHeap.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int heaphull2ParallelWithElapsedTime([In, Out] Point[] s, int n, ref double elapsedTime);
+
 		[DllImport("PatMorinImplementationOfChanAndHeap.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern int chanhull([In, Out] Point[] s, bool closeThePath, int n);
 
 		[DllImport("PatMorinImplementationOfChanAndHeap.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern int chanhullWithElapsedTime([In, Out] Point[] s, int n, ref double elapsedTime);
 
+		[DllImport("PatMorinImplementationOfChanAndHeap.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int chanhullParallelWithElapsedTime([In, Out] Point[] s, int n, ref double elapsedTime);
+
 		[DllImport("PatMorinImplementationOfChanAndHeap.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern int throwaway_heuristic([In, Out] Point[] s, int n);
 
@@ -128,6 +134,25 @@ namespace ConvexHullWorkbench
 			System.Array.Copy(rawPoints, indexHull, HullPoints, 0, NbPointsHull);
 		}
 
+		//-----------------------------------------------------------------------
+		public void HeapHullParallel()
+		{
+			int nb = NbPoints - NbPointThrown;
+			Point[] rawPoints = new Point[nb];
+			System.Array.Copy(SamplePoints, NbPointThrown, rawPoints, 0, nb);
+
+			double elapsedTime = 0;
+
+			int indexHull = NativeConvexHullApi.heaphull2ParallelWithElapsedTime(rawPoints, nb, ref elapsedTime);
+
+			TimeSpan = TimeSpanHelper.MoreAccurateTimeSpanFromSeconds(elapsedTime);
+
+			//copy the data to the Hull Array
+			NbPointsHull = nb - indexHull;
+			HullPoints = new Point[NbPointsHull];
+			System.Array.Copy(rawPoints, indexHull, HullPoints, 0, NbPointsHull);
+		}
+
 		//-----------------------------------------------------------------------
 		//public void ChanHull()
 		//{
@@ -170,6 +195,30 @@ namespace ConvexHullWorkbench
 			System.Array.Copy(SamplePoints, indexHull, HullPoints, 0, NbPointsHull);
 		}
 
+		//-----------------------------------------------------------------------
+		public void ChanHullParallel()
+		{
+			int nb = NbPoints - NbPointThrown;
+
+			double elapsedTime = 0;
+
+			if (SamplePoints == null || SamplePoints.Length == 0)
+			{
+				NbPointsHull = 0;
+				HullPoints = new Point[0];
+				return;
+			}
+
+			int indexHull = NativeConvexHullApi.chanhullParallelWithElapsedTime(SamplePoints, nb, ref elapsedTime);
+
+			TimeSpan = TimeSpanHelper.MoreAccurateTimeSpanFromSeconds(elapsedTime);
+
+			//copy the data to the Hull Array
+			NbPointsHull = nb - indexHull;
+			HullPoints = new Point[NbPointsHull];
+			System.Array.Copy(SamplePoints, indexHull, HullPoints, 0, NbPointsHull);
+		}
+
 		//-----------------------------------------------------------------------
 		public void ThrowAway()
 		{
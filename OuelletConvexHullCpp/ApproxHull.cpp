@@ -0,0 +1,402 @@
+#include "Stdafx.h"
+#include "ApproxHull.h"
+#include "OuelletHull.h"
+#include "HullCalipers.h"
+#include "HullQuery.h"
+#include <math.h>
+#include "CpuFeatures.h"
+#include <omp.h>
+
+// Points between two updates of the filter
+#define APPROX_HULL_BLOCK_SIZE 4096
+
+// Points per thread job of approxHull
+#define APPROX_HULL_JOB_SIZE 65536
+
+#pragma managed(push, off)
+
+// **************************************************************************
+ApproxHull::ApproxHull(double epsilon)
+{
+	double count = (epsilon > 0) ? 3.141592653589793 / sqrt(epsilon) : 65536;
+	count = count < 8 ? 8 : (count > 65536 ? 65536 : count);
+	_directionCount = 4 * (int)ceil(count / 4);
+	_isAvx2Supported = isAvx2Supported();
+
+	_pDirectionX = new double[_directionCount];
+	_pDirectionY = new double[_directionCount];
+	_pMax = new double[_directionCount];
+	_pBestX = new double[_directionCount];
+	_pBestY = new double[_directionCount];
+
+	int quarter = _directionCount / 4;
+	for (int n = 0; n < _directionCount; n++)
+	{
+		double angle = 6.283185307179586 * n / _directionCount;
+		_pDirectionX[n] = cos(angle);
+		_pDirectionY[n] = sin(angle);
+		_pMax[n] = -HUGE_VAL;
+		_pBestX[n] = 0;
+		_pBestY[n] = 0;
+	}
+
+	// Axis directions exactly, their extremes are the bounding box
+	for (int n = 0; n < 4; n++)
+	{
+		_pDirectionX[n * quarter] = (n == 0) ? 1 : (n == 2 ? -1 : 0);
+		_pDirectionY[n * quarter] = (n == 1) ? 1 : (n == 3 ? -1 : 0);
+	}
+}
+
+// **************************************************************************
+ApproxHull::~ApproxHull()
+{
+	delete[] _pDirectionX;
+	delete[] _pDirectionY;
+	delete[] _pMax;
+	delete[] _pBestX;
+	delete[] _pBestY;
+	delete _pInnerHull;
+}
+
+// **************************************************************************
+void ApproxHull::AddPoint(double x, double y)
+{
+#ifdef HULL_AVX2
+	if (_isAvx2Supported)
+	{
+		__m256d vx = _mm256_set1_pd(x);
+		__m256d vy = _mm256_set1_pd(y);
+		for (int n = 0; n < _directionCount; n += 4)
+		{
+			__m256d projection = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(_pDirectionX + n), vx),
+				_mm256_mul_pd(_mm256_loadu_pd(_pDirectionY + n), vy));
+			__m256d max = _mm256_loadu_pd(_pMax + n);
+			__m256d isBetter = _mm256_cmp_pd(projection, max, _CMP_GT_OQ);
+			_mm256_storeu_pd(_pMax + n, _mm256_blendv_pd(max, projection, isBetter));
+			_mm256_storeu_pd(_pBestX + n, _mm256_blendv_pd(_mm256_loadu_pd(_pBestX + n), vx, isBetter));
+			_mm256_storeu_pd(_pBestY + n, _mm256_blendv_pd(_mm256_loadu_pd(_pBestY + n), vy, isBetter));
+		}
+		return;
+	}
+#endif
+
+	for (int n = 0; n < _directionCount; n++)
+	{
+		double projection = _pDirectionX[n] * x + _pDirectionY[n] * y;
+		bool isBetter = projection > _pMax[n];
+		_pMax[n] = isBetter ? projection : _pMax[n];
+		_pBestX[n] = isBetter ? x : _pBestX[n];
+		_pBestY[n] = isBetter ? y : _pBestY[n];
+	}
+}
+
+// **************************************************************************
+// Points inside the hull of the current extremes can't be extremes. The hull is rebuilt after each block, as a
+// HullQuery (O(log k) per point), with an axis aligned box inside it in front of it (4 compares per point).
+// The box corners are the same as OuelletHull::GetInnerBox: around the center of the bounding box, the extreme
+// of each quadrant that spans the biggest rectangle. The box is kept when its corners are inside the hull.
+void ApproxHull::UpdateFilter()
+{
+	delete _pInnerHull;
+	_pInnerHull = NULL;
+	_hasInnerBox = false;
+	if (_count == 0)
+	{
+		return;
+	}
+
+	int64_t hullCount;
+	point* pHull = GetResultAsArray(hullCount, false);
+	if (hullCount < 3)
+	{
+		delete[] pHull;
+		return;
+	}
+	_pInnerHull = new HullQuery(pHull, hullCount);
+	delete[] pHull;
+
+	int quarter = _directionCount / 4;
+	point center = { (_pBestX[0] + _pBestX[2 * quarter]) / 2, (_pBestY[quarter] + _pBestY[3 * quarter]) / 2 };
+
+	point corners[4];
+	double areas[4] = { -1, -1, -1, -1 };
+	for (int n = 0; n < _directionCount; n++)
+	{
+		double dx = _pBestX[n] - center.x;
+		double dy = _pBestY[n] - center.y;
+		if (dx == 0 || dy == 0)
+		{
+			continue;
+		}
+
+		int quadrant = dx > 0 ? (dy > 0 ? 0 : 3) : (dy > 0 ? 1 : 2);
+		if (fabs(dx * dy) > areas[quadrant])
+		{
+			areas[quadrant] = fabs(dx * dy);
+			corners[quadrant].x = _pBestX[n];
+			corners[quadrant].y = _pBestY[n];
+		}
+	}
+
+	if (areas[0] < 0 || areas[1] < 0 || areas[2] < 0 || areas[3] < 0)
+	{
+		return;
+	}
+
+	_innerMin.x = corners[1].x > corners[2].x ? corners[1].x : corners[2].x;
+	_innerMax.x = corners[0].x < corners[3].x ? corners[0].x : corners[3].x;
+	_innerMin.y = corners[2].y > corners[3].y ? corners[2].y : corners[3].y;
+	_innerMax.y = corners[0].y < corners[1].y ? corners[0].y : corners[1].y;
+
+	if (!(_innerMin.x < _innerMax.x && _innerMin.y < _innerMax.y))
+	{
+		return;
+	}
+
+	point boxCorners[4] = { _innerMin, { _innerMax.x, _innerMin.y }, _innerMax, { _innerMin.x, _innerMax.y } };
+	for (int n = 0; n < 4; n++)
+	{
+		if (!_pInnerHull->Contains(boxCorners[n]))
+		{
+			return;
+		}
+	}
+
+	_hasInnerBox = true;
+}
+
+// **************************************************************************
+void ApproxHull::Add(const point* pPoints, int64_t count)
+{
+	for (int64_t blockStart = 0; blockStart < count; blockStart += APPROX_HULL_BLOCK_SIZE)
+	{
+		int64_t blockEnd = blockStart + APPROX_HULL_BLOCK_SIZE < count ? blockStart + APPROX_HULL_BLOCK_SIZE : count;
+
+		if (_pInnerHull != NULL)
+		{
+			// A point on the border of the hull can't be a better extreme either
+			for (int64_t n = blockStart; n < blockEnd; n++)
+			{
+				const point& pt = pPoints[n];
+				if (_hasInnerBox && pt.x > _innerMin.x && pt.x < _innerMax.x && pt.y > _innerMin.y && pt.y < _innerMax.y)
+				{
+					continue;
+				}
+				if (!_pInnerHull->Contains(pt))
+				{
+					AddPoint(pt.x, pt.y);
+				}
+			}
+		}
+		else
+		{
+			for (int64_t n = blockStart; n < blockEnd; n++)
+			{
+				AddPoint(pPoints[n].x, pPoints[n].y);
+			}
+		}
+
+		_count += blockEnd - blockStart;
+		UpdateFilter();
+	}
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
+void ApproxHull::Merge(const ApproxHull& other)
+{
+	for (int n = 0; n < _directionCount; n++)
+	{
+		if (other._pMax[n] > _pMax[n])
+		{
+			_pMax[n] = other._pMax[n];
+			_pBestX[n] = other._pBestX[n];
+			_pBestY[n] = other._pBestY[n];
+		}
+	}
+
+	_count += other._count;
+	UpdateFilter();
+}
+
+// **************************************************************************
+int64_t ApproxHull::Count() const
+{
+	return _count;
+}
+
+// **************************************************************************
+int ApproxHull::DirectionCount() const
+{
+	return _directionCount;
+}
+
+// **************************************************************************
+// Between the support lines of two following directions, the true hull can't go past their crossing point:
+// the farthest a point can be from the result is the distance from that crossing to the segment between
+// both extremes.
+double ApproxHull::ErrorBound() const
+{
+	if (_count == 0)
+	{
+		return 0;
+	}
+
+	double bound = 0;
+	for (int n = 0; n < _directionCount; n++)
+	{
+		int next = (n + 1 == _directionCount) ? 0 : n + 1;
+		point a = { _pBestX[n], _pBestY[n] };
+		point b = { _pBestX[next], _pBestY[next] };
+		if (compare_points(a, b))
+		{
+			continue;
+		}
+
+		double det = _pDirectionX[n] * _pDirectionY[next] - _pDirectionY[n] * _pDirectionX[next];
+		point v = { (_pMax[n] * _pDirectionY[next] - _pDirectionY[n] * _pMax[next]) / det,
+			(_pDirectionX[n] * _pMax[next] - _pMax[n] * _pDirectionX[next]) / det };
+
+		// Distance from v to the segment ab
+		double abx = b.x - a.x;
+		double aby = b.y - a.y;
+		double t = ((v.x - a.x) * abx + (v.y - a.y) * aby) / (abx * abx + aby * aby);
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		double dx = v.x - (a.x + t * abx);
+		double dy = v.y - (a.y + t * aby);
+		double distance = sqrt(dx * dx + dy * dy);
+
+		if (distance > bound)
+		{
+			bound = distance;
+		}
+	}
+
+	return bound;
+}
+
+// **************************************************************************
+double ApproxHull::RelativeErrorBound() const
+{
+	if (_count == 0)
+	{
+		return 0;
+	}
+
+	// The extremes polygon is convex and counter clockwise, copies of a point are removed
+	point* pPolygon = new point[_directionCount];
+	count_t polygonCount = 0;
+	for (int n = 0; n < _directionCount; n++)
+	{
+		point pt = { _pBestX[n], _pBestY[n] };
+		if (polygonCount == 0 || !compare_points(pPolygon[polygonCount - 1], pt))
+		{
+			pPolygon[polygonCount++] = pt;
+		}
+	}
+	if (polygonCount > 1 && compare_points(pPolygon[0], pPolygon[polygonCount - 1]))
+	{
+		polygonCount--;
+	}
+
+	HullMeasures measures;
+	hullMeasures(pPolygon, polygonCount, measures);
+	delete[] pPolygon;
+
+	double bound = ErrorBound();
+	if (measures.diameter == 0)
+	{
+		return bound == 0 ? 0 : HUGE_VAL;
+	}
+
+	return bound / measures.diameter;
+}
+
+// **************************************************************************
+point* ApproxHull::GetResultAsArray(int64_t& count, bool closeThePath)
+{
+	count = 0;
+	if (_count == 0)
+	{
+		return NULL;
+	}
+
+	point* pExtremes = new point[_directionCount];
+	for (int n = 0; n < _directionCount; n++)
+	{
+		pExtremes[n].x = _pBestX[n];
+		pExtremes[n].y = _pBestY[n];
+	}
+
+	point* results;
+	{
+		OuelletHull convexHull(pExtremes, _directionCount, closeThePath);
+		results = convexHull.GetResultAsArray(count);
+	}
+
+	delete[] pExtremes;
+	return results;
+}
+
+// **************************************************************************
+extern "C" point* approxHull(point* pPoints, int64_t count, double epsilon, bool closeThePath, int64_t& resultCount,
+	double& errorBound, double& relativeErrorBound)
+{
+	ApproxHull hull(epsilon);
+	int jobCount = (int)((count + APPROX_HULL_JOB_SIZE - 1) / APPROX_HULL_JOB_SIZE);
+
+#pragma omp parallel
+	{
+		ApproxHull threadHull(epsilon);
+
+#pragma omp for schedule(static)
+		for (int job = 0; job < jobCount; job++)
+		{
+			int64_t start = (int64_t)job * APPROX_HULL_JOB_SIZE;
+			threadHull.Add(pPoints + start, count - start < APPROX_HULL_JOB_SIZE ? count - start : APPROX_HULL_JOB_SIZE);
+		}
+
+#pragma omp critical
+		hull.Merge(threadHull);
+	}
+
+	errorBound = hull.ErrorBound();
+	relativeErrorBound = hull.RelativeErrorBound();
+	return hull.GetResultAsArray(resultCount, closeThePath);
+}
+
+// **************************************************************************
+extern "C" ApproxHull* approxHullCreate(double epsilon)
+{
+	return new ApproxHull(epsilon);
+}
+
+// **************************************************************************
+extern "C" void approxHullAdd(ApproxHull* pHull, point* pPoints, int64_t count)
+{
+	pHull->Add(pPoints, count);
+}
+
+// **************************************************************************
+extern "C" void approxHullMerge(ApproxHull* pHull, ApproxHull* pOther)
+{
+	pHull->Merge(*pOther);
+}
+
+// **************************************************************************
+extern "C" point* approxHullResult(ApproxHull* pHull, bool closeThePath, int64_t& resultCount, double& errorBound, double& relativeErrorBound)
+{
+	errorBound = pHull->ErrorBound();
+	relativeErrorBound = pHull->RelativeErrorBound();
+	return pHull->GetResultAsArray(resultCount, closeThePath);
+}
+
+// **************************************************************************
+extern "C" void approxHullDelete(ApproxHull* pHull)
+{
+	delete pHull;
+}
+
+// **************************************************************************
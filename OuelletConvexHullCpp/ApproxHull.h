@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Point.h"
+#include "HullQuery.h"
+
+// Approximate convex hull (epsilon hull) in one streaming pass.
+//
+// Keeps the extreme point in k evenly spaced directions, the 8 directions of throwaway_heuristic generalized:
+// k = pi / sqrt(epsilon) (multiple of 4, at least 8), memory is O(1 / sqrt(epsilon)). The result is the hull of
+// these extremes, inside the true hull. The true hull is inside the polygon made by the k support lines, so no
+// point is farther from the result than the triangles between both polygons: that bound is computed from the
+// result. On round hulls it is about epsilon * diameter / 4, long flat sides can make it bigger.
+// Points inside the current result can't be extremes: most of them are rejected by a box inside it (4 compares),
+// the others by a HullQuery on it (O(log k)).
+// The directions of a point are done 4 at a time with AVX2 (isAvx2Supported), otherwise with a branchless loop.
+//
+// Two ApproxHull with the same epsilon merge into the one of both point sets: shards and threads each fill
+// their own one.
+class ApproxHull
+{
+private:
+	int _directionCount;
+	double* _pDirectionX;
+	double* _pDirectionY;
+	double* _pMax; // Best projection on each direction
+	double* _pBestX; // Point that gives it
+	double* _pBestY;
+	int64_t _count = 0;
+	bool _isAvx2Supported;
+
+	HullQuery* _pInnerHull = NULL; // Hull of the extremes
+	bool _hasInnerBox = false; // Inside _pInnerHull
+	point _innerMin;
+	point _innerMax;
+
+	inline void AddPoint(double x, double y);
+	void UpdateFilter();
+
+public:
+	ApproxHull(double epsilon);
+	~ApproxHull();
+
+	void Add(const point* pPoints, int64_t count);
+	void Merge(const ApproxHull& other); // Same epsilon
+	int64_t Count() const; // Points added, including the merged ones
+	int DirectionCount() const;
+
+	double ErrorBound() const; // No point is farther than this from the result
+	double RelativeErrorBound() const; // ErrorBound / diameter of the result
+
+	point* GetResultAsArray(int64_t& count, bool closeThePath = true); // Same layout as OuelletHull. Free with delete[].
+};
+
+extern "C"
+{
+	// Points are shared between threads (one ApproxHull each, merged at the end)
+	point* approxHull(point* pPoints, int64_t count, double epsilon, bool closeThePath, int64_t& resultCount,
+		double& errorBound, double& relativeErrorBound);
+
+	ApproxHull* approxHullCreate(double epsilon);
+	void approxHullAdd(ApproxHull* pHull, point* pPoints, int64_t count);
+	void approxHullMerge(ApproxHull* pHull, ApproxHull* pOther);
+	point* approxHullResult(ApproxHull* pHull, bool closeThePath, int64_t& resultCount, double& errorBound, double& relativeErrorBound);
+	void approxHullDelete(ApproxHull* pHull);
+}
@@ -0,0 +1,292 @@
+#include "Stdafx.h"
+#include "AutoHull.h"
+#include "MonotoneChainHull.h"
+#include "OuelletHull.h"
+#include "../PatMorinImplementation/PatMorinImplementationOfChanAndHeap/src/chanhull.h"
+#include "../PatMorinImplementation/PatMorinImplementationOfChanAndHeap/src/heaphull.h"
+#include "../PatMorinImplementation/PatMorinImplementationOfChanAndHeap/src/throwaway.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <omp.h>
+
+// Points looked at before choosing
+#define AUTO_HULL_SAMPLE_SIZE 1024
+
+// From autoHullCalibrate(1000000) on an x64 desktop
+static AutoHullCostModel _costModel = { 15, 0.025, 300, 50, 27, 110, 9 };
+
+// **************************************************************************
+// Hull count of a sample sorted by x then y
+static count_t SampleHullCount(const point* pSample, count_t count)
+{
+	int64_t hullCount;
+	delete[] sortedMonotoneChainHull(pSample, count, false, false, hullCount);
+	return (count_t)hullCount;
+}
+
+// **************************************************************************
+// Copy a counter clockwise hull to the mergeHulls layout: starting at the rightmost (then highest) vertex,
+// closed if asked. Points all the same come as a count of 0 and the point (ouelletHull64) or as the point
+// twice (heaphull2): both give the single vertex of the monotone chain.
+static point* ToResultLayout(const point* pHull, count_t count, bool closeThePath, int64_t& resultCount)
+{
+	count_t first = 0;
+	bool isSinglePoint = true;
+	for (count_t n = 1; n < count; n++)
+	{
+		if (cmp(pHull[n], pHull[first]) > 0)
+		{
+			first = n;
+		}
+		isSinglePoint = isSinglePoint && compare_points(pHull[n], pHull[0]);
+	}
+
+	if (isSinglePoint)
+	{
+		count = 1;
+	}
+
+	point* results = new point[count + 1];
+	memcpy(results, pHull + first, (count - first) * sizeof(point));
+	memcpy(results + count - first, pHull, first * sizeof(point));
+
+	resultCount = count;
+	if (closeThePath && count > 0)
+	{
+		results[resultCount++] = results[0];
+	}
+
+	return results;
+}
+
+// **************************************************************************
+extern "C" point* autoHull(point* pPoints, int64_t count, bool closeThePath, int64_t& resultCount, AutoHullDecision& decision)
+{
+	memset(&decision, 0, sizeof(AutoHullDecision));
+	resultCount = 0;
+	if (count <= 0)
+	{
+		return NULL;
+	}
+
+	double startTime = omp_get_wtime();
+	AutoHullCostModel model = _costModel;
+	double pointCount = (double)count;
+
+	// Evenly spaced sample
+	count_t sampleCount = count < AUTO_HULL_SAMPLE_SIZE ? (count_t)count : AUTO_HULL_SAMPLE_SIZE;
+	count_t stride = (count_t)count / sampleCount;
+	point* pSample = new point[2 * sampleCount];
+	point* pScratch = pSample + sampleCount;
+	for (count_t n = 0; n < sampleCount; n++)
+	{
+		pSample[n] = pPoints[n * stride];
+	}
+
+	count_t ascendingCount = 0;
+	count_t descendingCount = 0;
+	for (count_t n = 1; n < sampleCount; n++)
+	{
+		int order = cmp(pSample[n - 1], pSample[n]);
+		ascendingCount += order <= 0;
+		descendingCount += order >= 0;
+	}
+	decision.orderedness = sampleCount > 1 ? (double)std::max(ascendingCount, descendingCount) / (sampleCount - 1) : 1;
+
+	memcpy(pScratch, pSample, sampleCount * sizeof(point));
+	decision.estimatedKeptFraction = (double)(sampleCount - (count_t)throwaway_heuristic_64(pScratch, sampleCount)) / sampleCount;
+
+	// Growth of the hull count between a quarter of the sample and all of it, hull count ~ n^growth
+	memcpy(pScratch, pSample, sampleCount * sizeof(point));
+	std::sort(pScratch, pScratch + sampleCount, [](const point& a, const point& b) { return cmp(a, b) < 0; });
+	decision.sampleCount = sampleCount;
+	decision.sampleHullCount = SampleHullCount(pScratch, sampleCount);
+	decision.estimatedHullCount = (double)decision.sampleHullCount;
+	if (sampleCount < count)
+	{
+		// Every 4th point, still sorted
+		count_t quarterCount = sampleCount / 4;
+		for (count_t n = 0; n < quarterCount; n++)
+		{
+			pScratch[n] = pScratch[4 * n];
+		}
+		count_t quarterHullCount = SampleHullCount(pScratch, quarterCount);
+
+		double growth = log((double)decision.sampleHullCount / std::max(quarterHullCount, (count_t)1)) / log(4.0);
+		growth = growth < 0 ? 0 : (growth > 1 ? 1 : growth);
+		decision.estimatedHullCount = std::min(decision.sampleHullCount * pow(pointCount / sampleCount, growth), pointCount);
+	}
+
+	bool isDescending = cmp(pSample[0], pSample[sampleCount - 1]) > 0;
+	delete[] pSample;
+
+	// Cheapest engine
+	double h = decision.estimatedHullCount;
+	double ouelletCost = pointCount * model.ouelletPerPoint + h * h * model.ouelletPerHullPointSquared;
+	double heapCost = pointCount * model.heapPerPoint;
+	double throwawayHeapCost = pointCount * (model.throwawayPerPoint + decision.estimatedKeptFraction * model.heapPerPoint);
+	double chanCost = pointCount * model.chanPerPointLogHull * log2(std::max(h, 2.0));
+
+	decision.engine = AutoHullOuellet;
+	double cost = ouelletCost;
+	if (heapCost < cost)
+	{
+		decision.engine = AutoHullHeap;
+		cost = heapCost;
+	}
+	if (throwawayHeapCost < cost)
+	{
+		decision.engine = AutoHullHeap;
+		decision.useThrowaway = true;
+		cost = throwawayHeapCost;
+	}
+	if (chanCost < cost)
+	{
+		decision.engine = AutoHullChan;
+		decision.useThrowaway = false;
+		cost = chanCost;
+	}
+	if (pointCount * model.radixChainPerPoint < cost)
+	{
+		decision.engine = AutoHullRadixChain;
+		decision.useThrowaway = false;
+		cost = pointCount * model.radixChainPerPoint;
+	}
+
+	// A sorted sample is not enough, all points are checked (only when it would pay)
+	if (decision.orderedness == 1 && pointCount * model.sortedChainPerPoint < cost && isSortedPoints(pPoints, count, isDescending))
+	{
+		decision.engine = AutoHullSortedChain;
+		decision.useThrowaway = false;
+		cost = pointCount * model.sortedChainPerPoint;
+	}
+	decision.estimatedSeconds = cost * 1e-9;
+
+	double hullStartTime = omp_get_wtime();
+	decision.samplingSeconds = hullStartTime - startTime;
+
+	point* results;
+	switch (decision.engine)
+	{
+	case AutoHullSortedChain:
+		results = sortedMonotoneChainHull(pPoints, count, isDescending, closeThePath, resultCount);
+		break;
+	case AutoHullRadixChain:
+		results = monotoneChainHull(pPoints, count, closeThePath, resultCount);
+		break;
+	case AutoHullHeap:
+	case AutoHullChan:
+	{
+		// All work in place
+		point* pCopy = new point[count];
+		memcpy(pCopy, pPoints, count * sizeof(point));
+		count_t start = decision.useThrowaway ? (count_t)throwaway_heuristic_64(pCopy, count) : 0;
+		start += decision.engine == AutoHullChan ? (count_t)chanhull_64(pCopy + start, count - start) :
+			(count_t)heaphull2_64(pCopy + start, count - start);
+		results = ToResultLayout(pCopy + start, (count_t)count - start, closeThePath, resultCount);
+		delete[] pCopy;
+		break;
+	}
+	default:
+	{
+		int64_t hullCount;
+		point* pHull = ouelletHull64(pPoints, count, false, hullCount);
+		results = ToResultLayout(pHull, (count_t)hullCount, closeThePath, resultCount);
+		delete[] pHull;
+		break;
+	}
+	}
+
+	decision.hullSeconds = omp_get_wtime() - hullStartTime;
+	return results;
+}
+
+// **************************************************************************
+extern "C" void autoHullGetCostModel(AutoHullCostModel& model)
+{
+	model = _costModel;
+}
+
+// **************************************************************************
+extern "C" void autoHullSetCostModel(const AutoHullCostModel& model)
+{
+	_costModel = model;
+}
+
+// **************************************************************************
+// Best of 3 runs, in nanoseconds per point. Engines that work in place get a fresh copy each run.
+template <typename Engine>
+static double TimePerPoint(const std::vector<point>& points, std::vector<point>& copy, Engine engine)
+{
+	double best = HUGE_VAL;
+	for (int run = 0; run < 3; run++)
+	{
+		copy = points;
+		double start = omp_get_wtime();
+		engine(copy.data(), (int64_t)copy.size());
+		double elapsed = omp_get_wtime() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return best * 1e9 / points.size();
+}
+
+// **************************************************************************
+extern "C" void autoHullCalibrate(int64_t pointCount, AutoHullCostModel& model)
+{
+	std::mt19937_64 random(12345);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+	// Small hull
+	std::vector<point> points((size_t)pointCount);
+	for (auto& pt : points)
+	{
+		pt.x = distribution(random);
+		pt.y = distribution(random);
+	}
+
+	std::vector<point> copy;
+	auto ouellet = [](point* pPoints, int64_t count)
+	{
+		int64_t resultCount;
+		delete[] ouelletHull64(pPoints, count, false, resultCount);
+	};
+
+	model.ouelletPerPoint = TimePerPoint(points, copy, ouellet);
+	model.heapPerPoint = TimePerPoint(points, copy, [](point* pPoints, int64_t count) { heaphull2_64(pPoints, count); });
+
+	int64_t hullCount;
+	delete[] ouelletHull64(points.data(), (int64_t)points.size(), false, hullCount);
+	model.chanPerPointLogHull = TimePerPoint(points, copy, [](point* pPoints, int64_t count) { chanhull_64(pPoints, count); })
+		/ log2((double)std::max(hullCount, (int64_t)2));
+	model.throwawayPerPoint = TimePerPoint(points, copy, [](point* pPoints, int64_t count) { throwaway_heuristic_64(pPoints, count); });
+	model.radixChainPerPoint = TimePerPoint(points, copy, [](point* pPoints, int64_t count)
+	{
+		int64_t hullCount;
+		delete[] monotoneChainHull(pPoints, count, false, hullCount);
+	});
+
+	std::sort(points.begin(), points.end(), [](const point& a, const point& b) { return cmp(a, b) < 0; });
+	model.sortedChainPerPoint = TimePerPoint(points, copy, [](point* pPoints, int64_t count)
+	{
+		int64_t hullCount;
+		delete[] sortedMonotoneChainHull(pPoints, count, false, false, hullCount);
+	});
+
+	// All points on the hull: what is above ouelletPerPoint is the quadratic part
+	points.resize((size_t)std::min(pointCount, (int64_t)20000));
+	for (auto& pt : points)
+	{
+		double angle = distribution(random) * 6.283185307179586;
+		pt.x = cos(angle);
+		pt.y = sin(angle);
+	}
+	double circlePerPoint = TimePerPoint(points, copy, ouellet);
+	model.ouelletPerHullPointSquared = std::max(circlePerPoint - model.ouelletPerPoint, 0.0) / points.size();
+
+	_costModel = model;
+}
+
+// **************************************************************************
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Point.h"
+
+// Engine chosen by autoHull
+enum AutoHullEngine
+{
+	AutoHullOuellet = 0, // OuelletHull
+	AutoHullHeap = 1, // Pat Morin heaphull2
+	AutoHullSortedChain = 2, // Monotone chain, input already sorted by x then y
+	AutoHullRadixChain = 3, // monotoneChainHull: radix sort, then monotone chain
+	AutoHullChan = 4, // Pat Morin chanhull
+};
+
+// Cost model of the engines, in nanoseconds. OuelletHull is fast while the hull is small but inserting in its
+// quadrant arrays makes it quadratic when most points are on the hull (circle like data), heaphull2 is
+// O(n log n) whatever the hull is, the throwaway prefilter is worth it when it removes most points and
+// sorted input only needs a monotone chain. A radix sort makes the monotone chain O(n) on any input. chanhull is
+// O(n log h): between both when the hull is too big for OuelletHull but far from all the points.
+struct AutoHullCostModel
+{
+	double ouelletPerPoint;
+	double ouelletPerHullPointSquared;
+	double heapPerPoint;
+	double throwawayPerPoint;
+	double sortedChainPerPoint;
+	double radixChainPerPoint;
+	double chanPerPointLogHull; // By point and log2 of the hull count
+};
+
+// What autoHull measured on its sample and what it did (instrumentation output)
+struct AutoHullDecision
+{
+	int engine; // AutoHullEngine
+	bool useThrowaway; // Throwaway prefilter before the engine
+	int64_t sampleCount;
+	int64_t sampleHullCount;
+	double estimatedHullCount;
+	double estimatedKeptFraction; // Part of the points kept by the throwaway prefilter
+	double orderedness; // 1: sample sorted by x (then y), ascending or descending. 0.5: random order.
+	double estimatedSeconds; // Of the chosen engine, from the cost model
+	double samplingSeconds;
+	double hullSeconds;
+};
+
+// Picks the engine from a sample of the input:
+// - Hull count: hulls of the sample and of a quarter of it give its growth rate, extrapolated to all points.
+// - Orderedness: sorted input (checked on all points when the sample is sorted) goes to a monotone chain, O(n).
+// - Kept fraction: points of the sample outside the hull of its 8 extremes, the ones throwaway would keep.
+// The cheapest engine of the cost model is then used. Whatever the engine, the result has the layout of
+// mergeHulls (counter clockwise, starting at the rightmost then highest vertex, one vertex when the points are
+// all the same), the input is not modified.
+extern "C"
+{
+	point* autoHull(point* pPoints, int64_t count, bool closeThePath, int64_t& resultCount, AutoHullDecision& decision);
+
+	void autoHullGetCostModel(AutoHullCostModel& model);
+	void autoHullSetCostModel(const AutoHullCostModel& model); // Ex: a calibration saved from a previous run
+
+	// Benchmark of the engines on this machine (pointCount random points and a circle), the cost model is set from it.
+	void autoHullCalibrate(int64_t pointCount, AutoHullCostModel& model);
+}
@@ -0,0 +1,46 @@
+#include "Stdafx.h"
+#include "CpuFeatures.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#pragma managed(push, off)
+
+// **************************************************************************
+static bool CheckAvx2()
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return false;
+	}
+
+	// AVX and OSXSAVE, then the OS saves the XMM and YMM registers
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+	{
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2") != 0;
+#else
+	return false;
+#endif
+}
+
+// **************************************************************************
+extern "C" bool isAvx2Supported()
+{
+	static const bool isSupported = CheckAvx2();
+	return isSupported;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
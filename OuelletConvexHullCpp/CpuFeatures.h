@@ -0,0 +1,15 @@
+#pragma once
+
+// AVX2 paths (HullQuery batches, ApproxHull directions) are compiled for x64 whatever /arch (MSVC needs no
+// option for the intrinsics) and taken only when isAvx2Supported: the DLL runs on any x64 CPU, at full speed
+// on the ones with AVX2. Other targets get them when built with AVX2.
+#if defined(_M_X64) || defined(__AVX2__)
+#define HULL_AVX2
+#include <immintrin.h>
+#endif
+
+extern "C"
+{
+	// The CPU has AVX2 and the OS saves the AVX registers. Checked once.
+	bool isAvx2Supported();
+}
@@ -0,0 +1,179 @@
+#include "Stdafx.h"
+#include "EnclosingCircle.h"
+#include "OuelletHull.h"
+#include <math.h>
+#include <string.h>
+#include <omp.h>
+
+// Up to this count of points, Welzl runs on the points themselves
+static const count_t _directPointCountMax = 64;
+
+// **************************************************************************
+// Slightly enlarged test, points found on the circle must stay in despite rounding
+static inline bool IsInCircle(const EnclosingCircle& circle, const point& pt)
+{
+	double dx = pt.x - circle.center.x;
+	double dy = pt.y - circle.center.y;
+	return dx * dx + dy * dy <= circle.radius * circle.radius * (1 + 1e-12);
+}
+
+// **************************************************************************
+static inline void CircleFrom2(const point& a, const point& b, EnclosingCircle& circle)
+{
+	circle.center.x = (a.x + b.x) / 2;
+	circle.center.y = (a.y + b.y) / 2;
+	circle.radius = sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y)) / 2;
+}
+
+// **************************************************************************
+static void CircleFrom3(const point& a, const point& b, const point& c, EnclosingCircle& circle)
+{
+	double bx = b.x - a.x;
+	double by = b.y - a.y;
+	double cx = c.x - a.x;
+	double cy = c.y - a.y;
+	double d = 2 * (bx * cy - by * cx);
+
+	if (d == 0) // Collinear: the 2 farthest ones
+	{
+		EnclosingCircle other;
+		CircleFrom2(a, b, circle);
+		CircleFrom2(a, c, other);
+		if (other.radius > circle.radius)
+		{
+			circle = other;
+		}
+		CircleFrom2(b, c, other);
+		if (other.radius > circle.radius)
+		{
+			circle = other;
+		}
+		return;
+	}
+
+	double b2 = bx * bx + by * by;
+	double c2 = cx * cx + cy * cy;
+	double ux = (cy * b2 - by * c2) / d;
+	double uy = (bx * c2 - cx * b2) / d;
+
+	circle.center.x = a.x + ux;
+	circle.center.y = a.y + uy;
+	circle.radius = sqrt(ux * ux + uy * uy);
+}
+
+// **************************************************************************
+// Welzl, iterative form. Points are shuffled in place first (fixed seed, results are repeatable).
+static void WelzlCircle(point* pPoints, count_t count, EnclosingCircle& circle)
+{
+	uint64_t random = 88172645463325252ull;
+	for (count_t n = count - 1; n > 0; n--)
+	{
+		random ^= random << 13;
+		random ^= random >> 7;
+		random ^= random << 17;
+		count_t other = (count_t)(random % (uint64_t)(n + 1));
+		point pt = pPoints[n];
+		pPoints[n] = pPoints[other];
+		pPoints[other] = pt;
+	}
+
+	circle.center = pPoints[0];
+	circle.radius = 0;
+
+	for (count_t i = 1; i < count; i++)
+	{
+		if (IsInCircle(circle, pPoints[i]))
+		{
+			continue;
+		}
+
+		// pPoints[i] is on the circle of the first i + 1 points
+		circle.center = pPoints[i];
+		circle.radius = 0;
+		for (count_t j = 0; j < i; j++)
+		{
+			if (IsInCircle(circle, pPoints[j]))
+			{
+				continue;
+			}
+
+			// pPoints[i] and pPoints[j] are on it
+			CircleFrom2(pPoints[i], pPoints[j], circle);
+			for (count_t k = 0; k < j; k++)
+			{
+				if (!IsInCircle(circle, pPoints[k]))
+				{
+					CircleFrom3(pPoints[i], pPoints[j], pPoints[k], circle);
+				}
+			}
+		}
+	}
+}
+
+// **************************************************************************
+// pScratch holds at least _directPointCountMax points.
+static bool MinCircle(point* pPoints, count_t count, point* pScratch, EnclosingCircle& circle)
+{
+	memset(&circle, 0, sizeof(EnclosingCircle));
+	if (count <= 0)
+	{
+		return false;
+	}
+
+	if (count <= _directPointCountMax)
+	{
+		memcpy(pScratch, pPoints, count * sizeof(point));
+		WelzlCircle(pScratch, count, circle);
+		return true;
+	}
+
+	int64_t hullCount;
+	OuelletHull convexHull(pPoints, count, false);
+	point* pHull = convexHull.GetResultAsArray(hullCount);
+
+	WelzlCircle(pHull, (count_t)hullCount, circle);
+
+	delete[] pHull;
+	return true;
+}
+
+// **************************************************************************
+extern "C" bool minEnclosingCircle(point* pPoints, int64_t count, EnclosingCircle& result)
+{
+	point scratch[_directPointCountMax];
+	return MinCircle(pPoints, (count_t)count, scratch, result);
+}
+
+// **************************************************************************
+extern "C" bool minEnclosingCircleOfHull(point* pHull, int64_t count, EnclosingCircle& result)
+{
+	memset(&result, 0, sizeof(EnclosingCircle));
+	if (count <= 0)
+	{
+		return false;
+	}
+
+	point* pCopy = new point[count];
+	memcpy(pCopy, pHull, count * sizeof(point));
+	WelzlCircle(pCopy, (count_t)count, result);
+	delete[] pCopy;
+	return true;
+}
+
+// **************************************************************************
+extern "C" void minEnclosingCircles(point* pPoints, int64_t* pClusterStarts, int clusterCount, EnclosingCircle* pCircles)
+{
+#pragma omp parallel
+	{
+		point scratch[_directPointCountMax];
+
+#pragma omp for schedule(dynamic, 256)
+		for (int n = 0; n < clusterCount; n++)
+		{
+			count_t start = (count_t)pClusterStarts[n];
+			MinCircle(pPoints + start, (count_t)pClusterStarts[n + 1] - start, scratch, pCircles[n]);
+		}
+	}
+}
+
+// **************************************************************************
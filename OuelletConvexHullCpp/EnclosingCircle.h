@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Point.h"
+
+struct EnclosingCircle
+{
+	point center;
+	double radius;
+};
+
+// Minimum enclosing circle. It only touches hull vertices, so the hull is found first (OuelletHull)
+// and Welzl's algorithm (iterative form, vertices in random order: expected O(h)) runs on its h vertices
+// instead of the n points. Small sets go to Welzl directly, the hull would cost more than it saves.
+//
+// Clustered layout: all the points in one array, cluster n is [pClusterStarts[n], pClusterStarts[n + 1]).
+// pClusterStarts has clusterCount + 1 entries.
+
+extern "C"
+{
+	bool minEnclosingCircle(point* pPoints, int64_t count, EnclosingCircle& result); // false (and all 0) when there is no point
+	bool minEnclosingCircleOfHull(point* pHull, int64_t count, EnclosingCircle& result); // Points already reduced to the hull (any order)
+
+	// One circle per cluster, clusters are shared between threads
+	void minEnclosingCircles(point* pPoints, int64_t* pClusterStarts, int clusterCount, EnclosingCircle* pCircles);
+}
@@ -0,0 +1,391 @@
+#include "Stdafx.h"
+#include "GroupedHull.h"
+#include "OuelletHull.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <omp.h>
+
+// Points of a new context
+#define GROUPED_HULL_INITIAL_CAPACITY 8
+
+// Contexts smaller than this are grown when full, not reduced
+#define GROUPED_HULL_REDUCE_CAPACITY 256
+
+// Pairs per thread job of groupedHull
+#define GROUPED_HULL_JOB_SIZE 65536
+
+#pragma managed(push, off)
+
+// **************************************************************************
+static inline count_t HashKey(int64_t key, int slotBits)
+{
+	return (count_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> (64 - slotBits));
+}
+
+// **************************************************************************
+GroupedHull::GroupedHull()
+{
+	_contextCapacity = 16;
+	_pContexts = new GroupedHullContext[_contextCapacity];
+
+	_slotBits = 5;
+	_pSlots = new count_t[(count_t)1 << _slotBits];
+	for (count_t n = 0; n < ((count_t)1 << _slotBits); n++)
+	{
+		_pSlots[n] = -1;
+	}
+}
+
+// **************************************************************************
+GroupedHull::~GroupedHull()
+{
+	for (count_t n = 0; n < _contextCount; n++)
+	{
+		delete[] _pContexts[n].pPoints;
+	}
+	delete[] _pContexts;
+	delete[] _pSlots;
+}
+
+// **************************************************************************
+void GroupedHull::Rehash(int slotBits)
+{
+	delete[] _pSlots;
+	_slotBits = slotBits;
+	count_t slotMask = ((count_t)1 << _slotBits) - 1;
+	_pSlots = new count_t[slotMask + 1];
+	for (count_t n = 0; n <= slotMask; n++)
+	{
+		_pSlots[n] = -1;
+	}
+
+	for (count_t n = 0; n < _contextCount; n++)
+	{
+		count_t slot = HashKey(_pContexts[n].key, _slotBits);
+		while (_pSlots[slot] >= 0)
+		{
+			slot = (slot + 1) & slotMask;
+		}
+		_pSlots[slot] = n;
+	}
+}
+
+// **************************************************************************
+// Context of the key, created empty when it is new
+count_t GroupedHull::GetContextIndex(int64_t key)
+{
+	count_t slotMask = ((count_t)1 << _slotBits) - 1;
+	count_t slot = HashKey(key, _slotBits);
+	while (_pSlots[slot] >= 0)
+	{
+		if (_pContexts[_pSlots[slot]].key == key)
+		{
+			return _pSlots[slot];
+		}
+		slot = (slot + 1) & slotMask;
+	}
+
+	if (_contextCount == _contextCapacity)
+	{
+		GroupedHullContext* pContexts = new GroupedHullContext[_contextCapacity * 2];
+		memcpy(pContexts, _pContexts, _contextCount * sizeof(GroupedHullContext));
+		delete[] _pContexts;
+		_pContexts = pContexts;
+		_contextCapacity *= 2;
+	}
+
+	GroupedHullContext& context = _pContexts[_contextCount];
+	context.key = key;
+	context.capacity = GROUPED_HULL_INITIAL_CAPACITY;
+	context.pPoints = new point[context.capacity];
+	context.count = 0;
+	context.hasInnerBox = false;
+
+	_pSlots[slot] = _contextCount;
+	_contextCount++;
+	if (2 * _contextCount > slotMask + 1)
+	{
+		Rehash(_slotBits + 1);
+	}
+
+	return _contextCount - 1;
+}
+
+// **************************************************************************
+// Axis aligned box strictly inside the hull so far, same corners as OuelletHull::GetInnerBox: around the center of
+// the bounding box, the vertex of each quadrant that spans the biggest rectangle. Kept when its corners are in the hull.
+void GroupedHull::UpdateInnerBox(GroupedHullContext& context)
+{
+	context.hasInnerBox = false;
+	const point* pHull = context.pPoints;
+	count_t count = context.count;
+	if (count < 3)
+	{
+		return;
+	}
+
+	point min = pHull[0];
+	point max = pHull[0];
+	for (count_t n = 1; n < count; n++)
+	{
+		min.x = pHull[n].x < min.x ? pHull[n].x : min.x;
+		min.y = pHull[n].y < min.y ? pHull[n].y : min.y;
+		max.x = pHull[n].x > max.x ? pHull[n].x : max.x;
+		max.y = pHull[n].y > max.y ? pHull[n].y : max.y;
+	}
+	point center = { (min.x + max.x) / 2, (min.y + max.y) / 2 };
+
+	point corners[4];
+	double areas[4] = { -1, -1, -1, -1 };
+	for (count_t n = 0; n < count; n++)
+	{
+		double dx = pHull[n].x - center.x;
+		double dy = pHull[n].y - center.y;
+		if (dx == 0 || dy == 0)
+		{
+			continue;
+		}
+
+		int quadrant = dx > 0 ? (dy > 0 ? 0 : 3) : (dy > 0 ? 1 : 2);
+		if (fabs(dx * dy) > areas[quadrant])
+		{
+			areas[quadrant] = fabs(dx * dy);
+			corners[quadrant] = pHull[n];
+		}
+	}
+
+	if (areas[0] < 0 || areas[1] < 0 || areas[2] < 0 || areas[3] < 0)
+	{
+		return;
+	}
+
+	context.innerMin.x = corners[1].x > corners[2].x ? corners[1].x : corners[2].x;
+	context.innerMax.x = corners[0].x < corners[3].x ? corners[0].x : corners[3].x;
+	context.innerMin.y = corners[2].y > corners[3].y ? corners[2].y : corners[3].y;
+	context.innerMax.y = corners[0].y < corners[1].y ? corners[0].y : corners[1].y;
+
+	if (!(context.innerMin.x < context.innerMax.x && context.innerMin.y < context.innerMax.y))
+	{
+		return;
+	}
+
+	// The hull is counter clockwise: a corner right of a side is outside
+	point boxCorners[4] = { context.innerMin, { context.innerMax.x, context.innerMin.y }, context.innerMax,
+		{ context.innerMin.x, context.innerMax.y } };
+	for (count_t n = 0; n < count; n++)
+	{
+		const point& next = pHull[n + 1 < count ? n + 1 : 0];
+		for (int k = 0; k < 4; k++)
+		{
+			if (right_turn(pHull[n], next, boxCorners[k]))
+			{
+				return;
+			}
+		}
+	}
+
+	context.hasInnerBox = true;
+}
+
+// **************************************************************************
+// The points of the context become its hull so far, the context is doubled when the hull takes more than half of
+// it: each reduction is paid by at least as many new points.
+void GroupedHull::Reduce(GroupedHullContext& context)
+{
+	int64_t hullCount;
+	point* pHull;
+	{
+		OuelletHull convexHull(context.pPoints, context.count, false);
+		pHull = convexHull.GetResultAsArray(hullCount);
+	}
+
+	if (hullCount == 0)
+	{
+		// All points the same: the first one is kept
+		context.count = 1;
+	}
+	else
+	{
+		if (hullCount > context.capacity / 2)
+		{
+			delete[] context.pPoints;
+			context.capacity *= 2;
+			context.pPoints = new point[context.capacity];
+		}
+		memcpy(context.pPoints, pHull, (size_t)hullCount * sizeof(point));
+		context.count = (count_t)hullCount;
+	}
+
+	delete[] pHull;
+	UpdateInnerBox(context);
+}
+
+// **************************************************************************
+void GroupedHull::AddPoint(GroupedHullContext& context, const point& pt)
+{
+	if (context.hasInnerBox && pt.x > context.innerMin.x && pt.x < context.innerMax.x &&
+		pt.y > context.innerMin.y && pt.y < context.innerMax.y)
+	{
+		return;
+	}
+
+	if (context.count == context.capacity)
+	{
+		if (context.capacity < GROUPED_HULL_REDUCE_CAPACITY)
+		{
+			point* pPoints = new point[context.capacity * 2];
+			memcpy(pPoints, context.pPoints, context.count * sizeof(point));
+			delete[] context.pPoints;
+			context.pPoints = pPoints;
+			context.capacity *= 2;
+		}
+		else
+		{
+			Reduce(context);
+		}
+	}
+
+	context.pPoints[context.count] = pt;
+	context.count++;
+}
+
+// **************************************************************************
+void GroupedHull::Add(const int64_t* pKeys, const point* pPoints, int64_t count)
+{
+	count_t contextIndex = -1;
+	for (int64_t n = 0; n < count; n++)
+	{
+		if (contextIndex < 0 || _pContexts[contextIndex].key != pKeys[n])
+		{
+			contextIndex = GetContextIndex(pKeys[n]);
+		}
+		AddPoint(_pContexts[contextIndex], pPoints[n]);
+	}
+}
+
+// **************************************************************************
+void GroupedHull::Merge(const GroupedHull& other)
+{
+	for (count_t n = 0; n < other._contextCount; n++)
+	{
+		const GroupedHullContext& otherContext = other._pContexts[n];
+		count_t contextIndex = GetContextIndex(otherContext.key);
+		for (count_t k = 0; k < otherContext.count; k++)
+		{
+			AddPoint(_pContexts[contextIndex], otherContext.pPoints[k]);
+		}
+	}
+}
+
+// **************************************************************************
+int64_t GroupedHull::GroupCount() const
+{
+	return _contextCount;
+}
+
+// **************************************************************************
+point* GroupedHull::GetResultAsArray(bool closeThePath, int64_t*& pKeys, int64_t*& pCounts, int64_t& groupCount, int64_t& resultCount)
+{
+	groupCount = _contextCount;
+	pKeys = new int64_t[groupCount];
+	pCounts = new int64_t[groupCount];
+
+	count_t* pOrder = new count_t[groupCount];
+	for (count_t n = 0; n < groupCount; n++)
+	{
+		pOrder[n] = n;
+	}
+	GroupedHullContext* pContexts = _pContexts;
+	std::sort(pOrder, pOrder + groupCount, [pContexts](count_t a, count_t b) { return pContexts[a].key < pContexts[b].key; });
+
+	// Last reduction of each group, with the layout of ouelletHull64
+	point** ppHulls = new point*[groupCount];
+#pragma omp parallel for schedule(dynamic, 16)
+	for (int n = 0; n < (int)groupCount; n++)
+	{
+		GroupedHullContext& context = _pContexts[pOrder[n]];
+		OuelletHull convexHull(context.pPoints, context.count, closeThePath);
+		ppHulls[n] = convexHull.GetResultAsArray(pCounts[n]);
+		pKeys[n] = context.key;
+	}
+
+	resultCount = 0;
+	for (count_t n = 0; n < groupCount; n++)
+	{
+		resultCount += pCounts[n];
+	}
+
+	point* results = new point[resultCount];
+	point* pResult = results;
+	for (count_t n = 0; n < groupCount; n++)
+	{
+		memcpy(pResult, ppHulls[n], (size_t)pCounts[n] * sizeof(point));
+		pResult += pCounts[n];
+		delete[] ppHulls[n];
+	}
+
+	delete[] ppHulls;
+	delete[] pOrder;
+	return results;
+}
+
+// **************************************************************************
+extern "C" point* groupedHull(const int64_t* pKeys, const point* pPoints, int64_t count, bool closeThePath,
+	int64_t*& pResultKeys, int64_t*& pResultCounts, int64_t& groupCount, int64_t& resultCount)
+{
+	GroupedHull hull;
+	int jobCount = (int)((count + GROUPED_HULL_JOB_SIZE - 1) / GROUPED_HULL_JOB_SIZE);
+
+#pragma omp parallel
+	{
+		GroupedHull threadHull;
+
+#pragma omp for schedule(static)
+		for (int job = 0; job < jobCount; job++)
+		{
+			int64_t start = (int64_t)job * GROUPED_HULL_JOB_SIZE;
+			threadHull.Add(pKeys + start, pPoints + start, count - start < GROUPED_HULL_JOB_SIZE ? count - start : GROUPED_HULL_JOB_SIZE);
+		}
+
+#pragma omp critical
+		hull.Merge(threadHull);
+	}
+
+	return hull.GetResultAsArray(closeThePath, pResultKeys, pResultCounts, groupCount, resultCount);
+}
+
+// **************************************************************************
+extern "C" GroupedHull* groupedHullCreate()
+{
+	return new GroupedHull();
+}
+
+// **************************************************************************
+extern "C" void groupedHullAdd(GroupedHull* pHull, const int64_t* pKeys, const point* pPoints, int64_t count)
+{
+	pHull->Add(pKeys, pPoints, count);
+}
+
+// **************************************************************************
+extern "C" void groupedHullMerge(GroupedHull* pHull, GroupedHull* pOther)
+{
+	pHull->Merge(*pOther);
+}
+
+// **************************************************************************
+extern "C" point* groupedHullResult(GroupedHull* pHull, bool closeThePath, int64_t*& pResultKeys, int64_t*& pResultCounts,
+	int64_t& groupCount, int64_t& resultCount)
+{
+	return pHull->GetResultAsArray(closeThePath, pResultKeys, pResultCounts, groupCount, resultCount);
+}
+
+// **************************************************************************
+extern "C" void groupedHullDelete(GroupedHull* pHull)
+{
+	delete pHull;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
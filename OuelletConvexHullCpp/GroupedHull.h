@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Point.h"
+
+// State of a key in GroupedHull
+struct GroupedHullContext
+{
+	int64_t key;
+	point* pPoints; // Hull so far (not closed, one point when all the same) then the points added since
+	count_t count;
+	count_t capacity;
+	bool hasInnerBox; // Strictly inside the hull so far
+	point innerMin;
+	point innerMax;
+};
+
+// One convex hull per key of an unsorted stream of (key, point), in one pass: no sort by key, and memory is
+// O(hull + new points) by key.
+//
+// Keys are found in an open addressing table (kept at most half full) of compact contexts, the last context is
+// reused as long as the key is the same (streams often have runs of a key). A context keeps the hull so far
+// followed by the points added since: when it is full, OuelletHull reduces it to the hull (its points first, in
+// hull order, then most of the new ones are rejected by them), and it is doubled when the hull takes more than
+// half of it. Small contexts are only grown, to keep tiny groups cheap. Points strictly inside a box inside the
+// hull so far (as OuelletHull::GetInnerBox) are rejected with 4 compares.
+//
+// Two GroupedHull merge into the one of both streams: threads each fill their own one.
+class GroupedHull
+{
+private:
+	GroupedHullContext* _pContexts;
+	count_t _contextCount = 0;
+	count_t _contextCapacity;
+	count_t* _pSlots; // Index in _pContexts, -1 for empty
+	int _slotBits;
+
+	count_t GetContextIndex(int64_t key);
+	void Rehash(int slotBits);
+	inline void AddPoint(GroupedHullContext& context, const point& pt);
+	static void Reduce(GroupedHullContext& context);
+	static void UpdateInnerBox(GroupedHullContext& context);
+
+public:
+	GroupedHull();
+	~GroupedHull();
+
+	void Add(const int64_t* pKeys, const point* pPoints, int64_t count);
+	void Merge(const GroupedHull& other);
+	int64_t GroupCount() const;
+
+	// Groups by increasing key: pKeys[n] and its hull of pCounts[n] points, after the ones of the groups before.
+	// Each hull is the one of ouelletHull64 on the points of its group (no point when they are all the same).
+	// Free the 3 arrays with delete[].
+	point* GetResultAsArray(bool closeThePath, int64_t*& pKeys, int64_t*& pCounts, int64_t& groupCount, int64_t& resultCount);
+};
+
+extern "C"
+{
+	// Pairs are shared between threads (one GroupedHull each, merged at the end)
+	point* groupedHull(const int64_t* pKeys, const point* pPoints, int64_t count, bool closeThePath,
+		int64_t*& pResultKeys, int64_t*& pResultCounts, int64_t& groupCount, int64_t& resultCount);
+
+	GroupedHull* groupedHullCreate();
+	void groupedHullAdd(GroupedHull* pHull, const int64_t* pKeys, const point* pPoints, int64_t count);
+	void groupedHullMerge(GroupedHull* pHull, GroupedHull* pOther);
+	point* groupedHullResult(GroupedHull* pHull, bool closeThePath, int64_t*& pResultKeys, int64_t*& pResultCounts,
+		int64_t& groupCount, int64_t& resultCount);
+	void groupedHullDelete(GroupedHull* pHull);
+}
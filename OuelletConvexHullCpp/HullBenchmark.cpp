@@ -0,0 +1,376 @@
+#include "Stdafx.h"
+#include "HullBenchmark.h"
+#include "AutoHull.h"
+#include "MonotoneChainHull.h"
+#include "OuelletHull.h"
+#include "ParallelHull.h"
+#include "../PatMorinImplementation/PatMorinImplementationOfChanAndHeap/src/chanhull.h"
+#include "../PatMorinImplementation/PatMorinImplementationOfChanAndHeap/src/heaphull.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <omp.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#pragma managed(push, off)
+
+// **************************************************************************
+// Thread n of the OpenMP team (0 is the calling thread) on the n-th core the process can use. The previous
+// masks are kept for UnpinThreads. False when the affinity can't be set.
+static bool PinThreads(std::vector<uint64_t>& previousMasks)
+{
+#ifdef _WIN32
+	DWORD_PTR processMask, systemMask;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+	{
+		return false;
+	}
+
+	std::vector<int> cores;
+	for (int core = 0; core < (int)sizeof(DWORD_PTR) * 8; core++)
+	{
+		if (processMask & ((DWORD_PTR)1 << core))
+		{
+			cores.push_back(core);
+		}
+	}
+
+	int threadCount = omp_get_max_threads();
+	previousMasks.assign(threadCount, 0);
+	bool isPinned = !cores.empty();
+	if (isPinned)
+	{
+#pragma omp parallel num_threads(threadCount)
+		{
+			int thread = omp_get_thread_num();
+			DWORD_PTR previousMask = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cores[thread % cores.size()]);
+			previousMasks[thread] = previousMask;
+			if (previousMask == 0)
+			{
+#pragma omp critical
+				isPinned = false;
+			}
+		}
+	}
+	return isPinned;
+#else
+	(void)previousMasks;
+	return false;
+#endif
+}
+
+// **************************************************************************
+static void UnpinThreads(const std::vector<uint64_t>& previousMasks)
+{
+#ifdef _WIN32
+#pragma omp parallel num_threads((int)previousMasks.size())
+	{
+		int thread = omp_get_thread_num();
+		if (previousMasks[thread] != 0)
+		{
+			SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)previousMasks[thread]);
+		}
+	}
+#else
+	(void)previousMasks;
+#endif
+}
+
+// **************************************************************************
+// Runs the engine on pWork, returns what must be freed (once the clock is stopped)
+static point* RunEngine(int engine, point* pWork, int64_t count, int64_t& hullCount)
+{
+	point* result = NULL;
+	switch (engine)
+	{
+	case HullBenchmarkOuellet:
+		result = ouelletHull64(pWork, count, false, hullCount);
+		break;
+	case HullBenchmarkHeap:
+		hullCount = count - heaphull2_64(pWork, count);
+		break;
+	case HullBenchmarkHeapParallel:
+		hullCount = count - heaphull2Parallel_64(pWork, count);
+		break;
+	case HullBenchmarkChan:
+		hullCount = count - chanhull_64(pWork, count);
+		break;
+	case HullBenchmarkChanParallel:
+		hullCount = count - chanhullParallel_64(pWork, count);
+		break;
+	case HullBenchmarkMonotoneChain:
+		result = monotoneChainHull(pWork, count, false, hullCount);
+		break;
+	case HullBenchmarkQuickHull:
+		result = parallelQuickHull(pWork, count, 0, false, hullCount);
+		break;
+	case HullBenchmarkDivideAndConquer:
+		result = parallelDivideAndConquerHull(pWork, count, 0, false, hullCount);
+		break;
+	case HullBenchmarkOuelletSinglePass:
+		result = ouelletHullSinglePass(pWork, count, false, hullCount);
+		break;
+	default:
+	{
+		AutoHullDecision decision;
+		result = autoHull(pWork, count, false, hullCount, decision);
+		break;
+	}
+	}
+	return result;
+}
+
+// **************************************************************************
+extern "C" bool hullBenchmark(int engine, const point* pPoints, int64_t count, const HullBenchmarkOptions& options,
+	HullBenchmarkResult& result, double* pSeconds)
+{
+	memset(&result, 0, sizeof(HullBenchmarkResult));
+	if (engine < HullBenchmarkOuellet || engine >= HullBenchmarkEngineCount || count <= 0)
+	{
+		return false;
+	}
+
+	std::vector<uint64_t> previousMasks;
+	result.isPinned = options.pinThreads && PinThreads(previousMasks);
+
+	int iterationCount = std::max(options.iterationCount, 1);
+	std::vector<double> seconds;
+	point* pWork = new point[count];
+	for (int run = 0; run < options.warmupCount + iterationCount; run++)
+	{
+		memcpy(pWork, pPoints, count * sizeof(point));
+
+		int64_t hullCount = 0;
+		double start = omp_get_wtime();
+		point* pResult = RunEngine(engine, pWork, count, hullCount);
+		double elapsed = omp_get_wtime() - start;
+		delete[] pResult;
+
+		if (run >= options.warmupCount)
+		{
+			seconds.push_back(elapsed);
+		}
+		result.hullCount = hullCount;
+	}
+	delete[] pWork;
+
+	if (!previousMasks.empty())
+	{
+		UnpinThreads(previousMasks);
+	}
+
+	if (pSeconds != NULL)
+	{
+		memcpy(pSeconds, seconds.data(), iterationCount * sizeof(double));
+	}
+
+	double sum = 0;
+	for (double value : seconds)
+	{
+		sum += value;
+	}
+	result.meanSeconds = sum / iterationCount;
+
+	double squareSum = 0;
+	for (double value : seconds)
+	{
+		squareSum += (value - result.meanSeconds) * (value - result.meanSeconds);
+	}
+	result.stddevSeconds = iterationCount > 1 ? sqrt(squareSum / (iterationCount - 1)) : 0;
+
+	std::sort(seconds.begin(), seconds.end());
+	result.iterationCount = iterationCount;
+	result.minSeconds = seconds[0];
+	result.medianSeconds = iterationCount % 2 ? seconds[iterationCount / 2] : (seconds[iterationCount / 2 - 1] + seconds[iterationCount / 2]) / 2;
+	result.p95Seconds = seconds[(size_t)ceil(0.95 * iterationCount) - 1];
+
+	return true;
+}
+
+// **************************************************************************
+extern "C" bool hullBenchmarkCounters(int engine, const point* pPoints, int64_t count, const HullBenchmarkOptions& options,
+	HullBenchmarkCounters& counters)
+{
+	static_assert(OuelletHullPhaseCount <= sizeof(counters.phases) / sizeof(counters.phases[0]), "HullBenchmarkCounters::phases");
+
+	memset(&counters, 0, sizeof(HullBenchmarkCounters));
+	if (engine < HullBenchmarkOuellet || engine >= HullBenchmarkEngineCount || count <= 0)
+	{
+		return false;
+	}
+
+	std::vector<uint64_t> previousMasks;
+	if (options.pinThreads)
+	{
+		PinThreads(previousMasks);
+	}
+
+	// Phase 0 is the whole call for the other engines
+	int phaseCount = engine == HullBenchmarkOuellet ? OuelletHullPhaseCount : 1;
+	PerfPhaseCounters phaseCounters(phaseCount);
+
+	int iterationCount = std::max(options.iterationCount, 1);
+	double seconds = 0;
+	point* pWork = new point[count];
+	for (int run = 0; run < options.warmupCount + iterationCount; run++)
+	{
+		memcpy(pWork, pPoints, count * sizeof(point));
+
+		// Warmup runs are not counted
+		PerfPhaseCounters* pPhaseCounters = run >= options.warmupCount ? &phaseCounters : NULL;
+
+		int64_t hullCount = 0;
+		point* pResult;
+		double start = omp_get_wtime();
+		if (engine == HullBenchmarkOuellet)
+		{
+			OuelletHull convexHull(pWork, (count_t)count, false, pPhaseCounters);
+			if (pPhaseCounters != NULL)
+			{
+				pPhaseCounters->Enter(OuelletHullPhaseResult);
+			}
+			pResult = convexHull.GetResultAsArray(hullCount);
+			if (pPhaseCounters != NULL)
+			{
+				pPhaseCounters->Enter(-1);
+			}
+		}
+		else
+		{
+			if (pPhaseCounters != NULL)
+			{
+				pPhaseCounters->Enter(0);
+			}
+			pResult = RunEngine(engine, pWork, count, hullCount);
+			if (pPhaseCounters != NULL)
+			{
+				pPhaseCounters->Enter(-1);
+			}
+		}
+		double elapsed = omp_get_wtime() - start;
+		delete[] pResult;
+
+		if (run >= options.warmupCount)
+		{
+			seconds += elapsed;
+		}
+	}
+	delete[] pWork;
+
+	if (!previousMasks.empty())
+	{
+		UnpinThreads(previousMasks);
+	}
+
+	counters.seconds = seconds / iterationCount;
+	counters.phaseCount = engine == HullBenchmarkOuellet ? OuelletHullPhaseCount : 0;
+
+	double pointRunCount = (double)count * iterationCount;
+	for (int counter = 0; counter < PerfCounterCount; counter++)
+	{
+		counters.isAvailable[counter] = phaseCounters.Counters().IsAvailable(counter);
+
+		for (int phase = 0; phase < phaseCount; phase++)
+		{
+			double value = phaseCounters.Values(phase)[counter] / pointRunCount;
+			counters.total[counter] += value;
+			if (counters.phaseCount > 0)
+			{
+				counters.phases[phase][counter] = value;
+			}
+		}
+	}
+
+	return true;
+}
+
+// **************************************************************************
+extern "C" bool hullBenchmarkPhases(const point* pPoints, int64_t count, const HullBenchmarkOptions& options, double* pPhaseSeconds)
+{
+	if (count <= 0)
+	{
+		return false;
+	}
+
+	std::vector<uint64_t> previousMasks;
+	if (options.pinThreads)
+	{
+		PinThreads(previousMasks);
+	}
+
+	int iterationCount = std::max(options.iterationCount, 1);
+	point* pWork = new point[count];
+	for (int run = 0; run < options.warmupCount + iterationCount; run++)
+	{
+		memcpy(pWork, pPoints, count * sizeof(point));
+
+		PerfPhaseCounters phaseCounters(OuelletHullPhaseCount, false);
+		int64_t hullCount;
+		point* pResult;
+		{
+			OuelletHull convexHull(pWork, (count_t)count, false, &phaseCounters);
+			phaseCounters.Enter(OuelletHullPhaseResult);
+			pResult = convexHull.GetResultAsArray(hullCount);
+			phaseCounters.Enter(-1);
+		}
+		delete[] pResult;
+
+		if (run >= options.warmupCount)
+		{
+			for (int phase = 0; phase < OuelletHullPhaseCount; phase++)
+			{
+				pPhaseSeconds[(run - options.warmupCount) * OuelletHullPhaseCount + phase] = phaseCounters.Seconds(phase);
+			}
+		}
+	}
+	delete[] pWork;
+
+	if (!previousMasks.empty())
+	{
+		UnpinThreads(previousMasks);
+	}
+
+	return true;
+}
+
+// **************************************************************************
+extern "C" void hullScalingBenchmark(int64_t pointCount, int64_t hullCount, double& chanSeconds, double& heapSeconds,
+	double& ouelletSeconds)
+{
+	std::mt19937_64 random(12345);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+	hullCount = std::max(std::min(hullCount, pointCount), (int64_t)3);
+	pointCount = std::max(pointCount, hullCount);
+	std::vector<point> points((size_t)pointCount);
+
+	// Inside the circle inscribed in the polygon
+	double innerRadius = cos(3.141592653589793 / hullCount) * 0.999;
+	for (int64_t n = 0; n < pointCount; n++)
+	{
+		double angle = n < hullCount ? n * 6.283185307179586 / hullCount : distribution(random) * 6.283185307179586;
+		double radius = n < hullCount ? 1 : sqrt(distribution(random)) * innerRadius;
+		points[(size_t)n].x = radius * cos(angle);
+		points[(size_t)n].y = radius * sin(angle);
+	}
+	std::shuffle(points.begin(), points.end(), random);
+
+	HullBenchmarkOptions options = { 0, 3, false };
+	HullBenchmarkResult result;
+	hullBenchmark(HullBenchmarkChan, points.data(), pointCount, options, result, NULL);
+	chanSeconds = result.minSeconds;
+	hullBenchmark(HullBenchmarkHeap, points.data(), pointCount, options, result, NULL);
+	heapSeconds = result.minSeconds;
+	hullBenchmark(HullBenchmarkOuellet, points.data(), pointCount, options, result, NULL);
+	ouelletSeconds = result.minSeconds;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Point.h"
+#include "PerfCounters.h"
+
+// Engines of hullBenchmark
+enum HullBenchmarkEngine
+{
+	HullBenchmarkOuellet = 0, // ouelletHull64
+	HullBenchmarkHeap = 1, // heaphull2_64
+	HullBenchmarkHeapParallel = 2, // heaphull2Parallel_64
+	HullBenchmarkChan = 3, // chanhull_64
+	HullBenchmarkChanParallel = 4, // chanhullParallel_64
+	HullBenchmarkMonotoneChain = 5, // monotoneChainHull
+	HullBenchmarkQuickHull = 6, // parallelQuickHull, one thread per core
+	HullBenchmarkDivideAndConquer = 7, // parallelDivideAndConquerHull, one thread per core
+	HullBenchmarkAuto = 8, // autoHull
+	HullBenchmarkOuelletSinglePass = 9, // ouelletHullSinglePass
+	HullBenchmarkEngineCount = 10,
+};
+
+struct HullBenchmarkOptions
+{
+	int warmupCount; // Runs before the measured ones, not measured
+	int iterationCount; // Measured runs
+	bool pinThreads; // The calling thread and the OpenMP threads each on their own core, during the benchmark (Windows only)
+};
+
+// In seconds
+struct HullBenchmarkResult
+{
+	int iterationCount;
+	int64_t hullCount; // Of the last run
+	bool isPinned; // pinThreads was asked and done
+	double minSeconds;
+	double medianSeconds;
+	double p95Seconds; // Nearest rank
+	double meanSeconds;
+	double stddevSeconds; // Sample standard deviation
+};
+
+// Hardware counters of hullBenchmarkCounters, by input point and run
+struct HullBenchmarkCounters
+{
+	bool isAvailable[PerfCounterCount]; // The others are 0
+	double total[PerfCounterCount]; // Of the engine call
+	int phaseCount; // OuelletHullPhaseCount for HullBenchmarkOuellet, 0 for the other engines
+	double phases[4][PerfCounterCount]; // By OuelletHullPhase
+	double seconds; // Mean of the measured runs (whole run, not by point), counter reads included
+};
+
+// Repeated runs of an engine on equal footing: every run (warmup or measured) gets its own copy of the points,
+// made before the clock starts (heaphull2 and chanhull reorder their input), and the result is freed after it
+// stops. Only the engine call is timed.
+extern "C"
+{
+	// pSeconds: NULL or room for iterationCount times, in run order. Returns false for an unknown engine or no points.
+	bool hullBenchmark(int engine, const point* pPoints, int64_t count, const HullBenchmarkOptions& options,
+		HullBenchmarkResult& result, double* pSeconds);
+
+	// PerfCounters of the engine on the same footing as hullBenchmark, split by OuelletHullPhase for OuelletHull
+	// (search against the quadrant hulls vs moves in their arrays). Counters follow the calling thread and the
+	// threads it starts (TaskScheduler of the task parallel hulls), not the OpenMP threads already running: for
+	// the OpenMP engines only the work of the calling thread is counted. Counters are Linux only: elsewhere or
+	// when the system has none, isAvailable is false and only seconds is measured. Returns false for an unknown
+	// engine or no points.
+	bool hullBenchmarkCounters(int engine, const point* pPoints, int64_t count, const HullBenchmarkOptions& options,
+		HullBenchmarkCounters& counters);
+	// Wall time of each OuelletHullPhase of OuelletHull, runs as in hullBenchmark (no counter is read).
+	// pPhaseSeconds: iterationCount x OuelletHullPhaseCount, run after run. Returns false for no points.
+	bool hullBenchmarkPhases(const point* pPoints, int64_t count, const HullBenchmarkOptions& options, double* pPhaseSeconds);
+
+	// Output sensitivity: hullCount points evenly spaced on a circle, the others random inside the polygon they
+	// make, shuffled. Best of 3 runs of chanhull, heaphull2 and ouelletHull64, in seconds. Chan is O(n log h),
+	// heaphull2 O(n log n) and OuelletHull O(n + h^2).
+	void hullScalingBenchmark(int64_t pointCount, int64_t hullCount, double& chanSeconds, double& heapSeconds,
+		double& ouelletSeconds);
+}
@@ -0,0 +1,228 @@
+#include "Stdafx.h"
+#include "HullCalipers.h"
+#include <math.h>
+#include <string.h>
+#include <omp.h>
+
+#define dot(a, b, u) (((b).x - (a).x) * (u).x + ((b).y - (a).y) * (u).y)
+
+// **************************************************************************
+static double Distance(const point& a, const point& b)
+{
+	double dx = b.x - a.x;
+	double dy = b.y - a.y;
+	return sqrt(dx * dx + dy * dy);
+}
+
+// **************************************************************************
+// Keeps the squared distance until the end of Measure
+static void SetDiameter(HullMeasures& measures, const point& a, const point& b)
+{
+	double dx = b.x - a.x;
+	double dy = b.y - a.y;
+	double distance = dx * dx + dy * dy;
+	if (distance > measures.diameter)
+	{
+		measures.diameter = distance;
+		measures.diameterStart = a;
+		measures.diameterEnd = b;
+	}
+}
+
+// **************************************************************************
+// Rectangle with one side on the line (origin, direction u), from "low" to "high" along u and "height" to the left.
+static void SetRectangle(HullRectangle& rectangle, const point& origin, const point& u, double low, double high, double height)
+{
+	point normal = { -u.y, u.x };
+
+	rectangle.corners[0].x = origin.x + u.x * low;
+	rectangle.corners[0].y = origin.y + u.y * low;
+	rectangle.corners[1].x = origin.x + u.x * high;
+	rectangle.corners[1].y = origin.y + u.y * high;
+	rectangle.corners[2].x = rectangle.corners[1].x + normal.x * height;
+	rectangle.corners[2].y = rectangle.corners[1].y + normal.y * height;
+	rectangle.corners[3].x = rectangle.corners[0].x + normal.x * height;
+	rectangle.corners[3].y = rectangle.corners[0].y + normal.y * height;
+	rectangle.area = (high - low) * height;
+	rectangle.perimeter = 2 * ((high - low) + height);
+}
+
+// **************************************************************************
+// Flat hull: the segment is the diameter and both rectangles.
+static void MeasureSegment(const point& a, const point& b, HullMeasures& measures)
+{
+	double length = Distance(a, b);
+	measures.diameter = length;
+	measures.diameterStart = a;
+	measures.diameterEnd = b;
+	measures.width = 0;
+
+	if (length == 0)
+	{
+		return;
+	}
+
+	point u = { (b.x - a.x) / length, (b.y - a.y) / length };
+	SetRectangle(measures.minAreaRectangle, a, u, 0, length, 0);
+	measures.minPerimeterRectangle = measures.minAreaRectangle;
+}
+
+// **************************************************************************
+static bool Measure(const point* pHull, count_t count, HullMeasures& measures)
+{
+	memset(&measures, 0, sizeof(HullMeasures));
+
+	if (count > 1 && compare_points(pHull[0], pHull[count - 1])) // Closed path
+	{
+		count--;
+	}
+
+	if (count <= 0)
+	{
+		return false;
+	}
+
+	measures.diameterStart = measures.diameterEnd = pHull[0];
+	for (int n = 0; n < 4; n++)
+	{
+		measures.minAreaRectangle.corners[n] = measures.minPerimeterRectangle.corners[n] = pHull[0];
+	}
+
+	if (count == 1)
+	{
+		return true;
+	}
+
+	if (count == 2)
+	{
+		MeasureSegment(pHull[0], pHull[1], measures);
+		return true;
+	}
+
+	// Calipers for edge (i, i + 1): "top" is the farthest vertex from its line, "right" and "left" the
+	// farthest ones forward and backward along it. None of them goes back when the edge turns.
+	count_t top = 0;
+	count_t right = 0;
+	count_t left = 0;
+	bool isFirst = true;
+
+	measures.width = HUGE_VAL;
+	measures.minAreaRectangle.area = HUGE_VAL;
+	measures.minPerimeterRectangle.perimeter = HUGE_VAL;
+
+	for (count_t i = 0; i < count; i++)
+	{
+		const point& a = pHull[i];
+		const point& b = pHull[i + 1 == count ? 0 : i + 1];
+		double length = Distance(a, b);
+		if (length == 0)
+		{
+			continue;
+		}
+
+		point u = { (b.x - a.x) / length, (b.y - a.y) / length };
+
+		if (isFirst)
+		{
+			top = right = i + 1 == count ? 0 : i + 1;
+		}
+
+		// Each caliper stops on the first vertex of a tie: less than "count" steps overall.
+		// Vertices passed by "top" are antipodal to "a".
+		SetDiameter(measures, a, pHull[top]);
+		count_t next = top + 1 == count ? 0 : top + 1;
+		while (area(a, b, pHull[next]) > area(a, b, pHull[top]))
+		{
+			top = next;
+			next = top + 1 == count ? 0 : top + 1;
+			SetDiameter(measures, a, pHull[top]);
+		}
+
+		next = right + 1 == count ? 0 : right + 1;
+		while (dot(pHull[right], pHull[next], u) > 0)
+		{
+			right = next;
+			next = right + 1 == count ? 0 : right + 1;
+		}
+
+		if (isFirst)
+		{
+			if (area(a, b, pHull[top]) == 0) // Every vertex is on the line of the edge
+			{
+				count_t low = 0;
+				count_t high = 0;
+				for (count_t n = 1; n < count; n++)
+				{
+					low = dot(pHull[low], pHull[n], u) < 0 ? n : low;
+					high = dot(pHull[high], pHull[n], u) > 0 ? n : high;
+				}
+				MeasureSegment(pHull[low], pHull[high], measures);
+				return true;
+			}
+
+			left = top;
+			isFirst = false;
+		}
+		next = left + 1 == count ? 0 : left + 1;
+		while (dot(pHull[left], pHull[next], u) < 0)
+		{
+			left = next;
+			next = left + 1 == count ? 0 : left + 1;
+		}
+
+		// "b" is antipodal to "top", and to the vertex after it when both are as far (parallel edges)
+		next = top + 1 == count ? 0 : top + 1;
+		SetDiameter(measures, b, pHull[top]);
+		SetDiameter(measures, a, pHull[next]);
+		SetDiameter(measures, b, pHull[next]);
+
+		double height = area(a, b, pHull[top]) / length;
+		if (height < measures.width)
+		{
+			measures.width = height;
+		}
+
+		double low = dot(a, pHull[left], u);
+		double high = dot(a, pHull[right], u);
+		double rectangleArea = (high - low) * height;
+		double rectanglePerimeter = 2 * ((high - low) + height);
+
+		if (rectangleArea < measures.minAreaRectangle.area)
+		{
+			SetRectangle(measures.minAreaRectangle, a, u, low, high, height);
+		}
+		if (rectanglePerimeter < measures.minPerimeterRectangle.perimeter)
+		{
+			SetRectangle(measures.minPerimeterRectangle, a, u, low, high, height);
+		}
+	}
+
+	measures.diameter = sqrt(measures.diameter);
+
+	if (isFirst) // Every vertex is the same point
+	{
+		measures.width = 0;
+		measures.minAreaRectangle.area = 0;
+		measures.minPerimeterRectangle.perimeter = 0;
+	}
+
+	return true;
+}
+
+// **************************************************************************
+extern "C" bool hullMeasures(point* pHull, int64_t count, HullMeasures& measures)
+{
+	return Measure(pHull, (count_t)count, measures);
+}
+
+// **************************************************************************
+extern "C" void hullMeasuresBatch(point** ppHulls, int64_t* pCounts, int hullCount, HullMeasures* pMeasures)
+{
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int n = 0; n < hullCount; n++)
+	{
+		Measure(ppHulls[n], (count_t)pCounts[n], pMeasures[n]);
+	}
+}
+
+// **************************************************************************
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Point.h"
+
+// Rectangle enclosing a hull, one side on a hull edge. Corners are counter clockwise.
+struct HullRectangle
+{
+	point corners[4];
+	double area;
+	double perimeter;
+};
+
+// Measures of a convex polygon, as returned by OuelletHull::GetResultAsArray (counter clockwise, closed or not).
+// A single point or a segment gives flat rectangles (area 0).
+struct HullMeasures
+{
+	double diameter; // Longest distance between 2 vertices
+	point diameterStart;
+	point diameterEnd;
+	double width; // Smallest distance between 2 parallel lines that enclose the hull
+	HullRectangle minAreaRectangle;
+	HullRectangle minPerimeterRectangle;
+};
+
+// Rotating calipers: for each edge, the farthest vertex from its line and the extreme vertices along it
+// only move forward around the polygon, all measures are found in one O(h) turn.
+
+extern "C"
+{
+	bool hullMeasures(point* pHull, int64_t count, HullMeasures& measures); // false (and all 0) for an empty hull
+
+	// One measure per hull, hulls are shared between threads
+	void hullMeasuresBatch(point** ppHulls, int64_t* pCounts, int hullCount, HullMeasures* pMeasures);
+}
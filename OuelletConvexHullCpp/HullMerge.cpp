@@ -0,0 +1,270 @@
+#include "Stdafx.h"
+#include "HullMerge.h"
+#include "Point.h"
+#include <utility>
+#include <omp.h>
+
+#define lex_less(a, b) ((a).x < (b).x || ((a).x == (b).x && (a).y < (b).y))
+
+// **************************************************************************
+// Split a counter clockwise convex polygon in its lower and upper chains. Both chains go from
+// the lowest leftmost vertex to the highest rightmost vertex (increasing x) and include them.
+static void SplitChains(const point* pHull, count_t count, point* pLower, count_t& lowerCount, point* pUpper, count_t& upperCount)
+{
+	lowerCount = 0;
+	upperCount = 0;
+
+	if (count > 1 && compare_points(pHull[0], pHull[count - 1])) // Closed path
+	{
+		count--;
+	}
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	count_t indexMin = 0;
+	count_t indexMax = 0;
+	for (count_t n = 1; n < count; n++)
+	{
+		if (lex_less(pHull[n], pHull[indexMin]))
+		{
+			indexMin = n;
+		}
+		if (lex_less(pHull[indexMax], pHull[n]))
+		{
+			indexMax = n;
+		}
+	}
+
+	// Counter clockwise from min to max is the lower chain
+	count_t index = indexMin;
+	while (true)
+	{
+		pLower[lowerCount++] = pHull[index];
+		if (index == indexMax)
+		{
+			break;
+		}
+		index = (index + 1 == count) ? 0 : index + 1;
+	}
+
+	// Clockwise from min to max is the upper chain
+	index = indexMin;
+	while (true)
+	{
+		pUpper[upperCount++] = pHull[index];
+		if (index == indexMax)
+		{
+			break;
+		}
+		index = (index == 0) ? count - 1 : index - 1;
+	}
+}
+
+// **************************************************************************
+// Merge two x sorted chains and keep their convex part (Andrew's monotone chain on already sorted input).
+// side = 1 keeps left turns (lower hull), side = -1 keeps right turns (upper hull).
+static count_t MergeChains(const point* pChain1, count_t count1, const point* pChain2, count_t count2, int side, point* pOut)
+{
+	count_t index1 = 0;
+	count_t index2 = 0;
+	count_t count = 0;
+	point pt;
+
+	while (index1 < count1 || index2 < count2)
+	{
+		if (index2 >= count2 || (index1 < count1 && !lex_less(pChain2[index2], pChain1[index1])))
+		{
+			pt = pChain1[index1++];
+		}
+		else
+		{
+			pt = pChain2[index2++];
+		}
+
+		while (count >= 2 && side * area(pOut[count - 2], pOut[count - 1], pt) <= 0)
+		{
+			count--;
+		}
+
+		if (count == 1 && compare_points(pOut[0], pt))
+		{
+			continue;
+		}
+
+		pOut[count++] = pt;
+	}
+
+	return count;
+}
+
+// **************************************************************************
+static point* MergeTwoHulls(const point* pHull1, count_t count1, const point* pHull2, count_t count2, bool closeThePath, count_t& resultCount)
+{
+	resultCount = 0;
+
+	// Points all the same: GetResultAsArray gives a count of 0 and the point
+	if (count1 == 0 && pHull1 != NULL)
+	{
+		count1 = 1;
+	}
+	if (count2 == 0 && pHull2 != NULL)
+	{
+		count2 = 1;
+	}
+
+	point* pBuffer = new point[2 * (count1 + count2) + 4];
+	point* pLower1 = pBuffer;
+	point* pUpper1 = pLower1 + count1 + 1;
+	point* pLower2 = pUpper1 + count1 + 1;
+	point* pUpper2 = pLower2 + count2 + 1;
+
+	count_t lower1Count, upper1Count, lower2Count, upper2Count;
+	SplitChains(pHull1, count1, pLower1, lower1Count, pUpper1, upper1Count);
+	SplitChains(pHull2, count2, pLower2, lower2Count, pUpper2, upper2Count);
+
+	point* pLower = new point[lower1Count + lower2Count + upper1Count + upper2Count + 1];
+	point* pUpper = pLower + lower1Count + lower2Count;
+
+	count_t lowerCount = MergeChains(pLower1, lower1Count, pLower2, lower2Count, 1, pLower);
+	count_t upperCount = MergeChains(pUpper1, upper1Count, pUpper2, upper2Count, -1, pUpper);
+
+	delete[] pBuffer;
+
+	if (lowerCount == 0)
+	{
+		delete[] pLower;
+		return NULL;
+	}
+
+	point* results;
+
+	if (lowerCount == 1) // Only one point, or many times the same one
+	{
+		results = new point[1]{ pLower[0] };
+		resultCount = 1;
+	}
+	else
+	{
+		// Upper chain backward (from the rightmost to the leftmost vertex), then the lower chain without its ends
+		count_t countOfFinalHullPoint = upperCount + lowerCount - 2;
+		results = new point[closeThePath ? countOfFinalHullPoint + 1 : countOfFinalHullPoint];
+
+		count_t resIndex = 0;
+		for (count_t n = upperCount - 1; n >= 0; n--)
+		{
+			results[resIndex++] = pUpper[n];
+		}
+
+		for (count_t n = 1; n < lowerCount - 1; n++)
+		{
+			results[resIndex++] = pLower[n];
+		}
+
+		if (closeThePath)
+		{
+			results[resIndex++] = results[0];
+		}
+
+		resultCount = resIndex;
+	}
+
+	delete[] pLower;
+	return results;
+}
+
+// **************************************************************************
+extern "C" point* mergeHulls(point* pHull1, int64_t count1, point* pHull2, int64_t count2, bool closeThePath, int64_t& resultCount)
+{
+	count_t count;
+	point* results = MergeTwoHulls(pHull1, (count_t)count1, pHull2, (count_t)count2, closeThePath, count);
+	resultCount = count;
+	return results;
+}
+
+// **************************************************************************
+extern "C" point* mergeManyHulls(point** ppHulls, int64_t* pCounts, int hullCount, bool closeThePath, int64_t& resultCount)
+{
+	resultCount = 0;
+	if (hullCount <= 0)
+	{
+		return NULL;
+	}
+
+	if (hullCount == 1)
+	{
+		return mergeHulls(ppHulls[0], pCounts[0], NULL, 0, closeThePath, resultCount);
+	}
+
+	// Intermediate levels are kept open (not closed), only the last merge closes the path if asked.
+	// Caller arrays are never freed, only the intermediate results (owned).
+	point** ppLevel = new point*[hullCount];
+	count_t* pLevelCounts = new count_t[hullCount];
+	bool* pOwned = new bool[hullCount];
+
+	point** ppNextLevel = new point*[hullCount];
+	count_t* pNextLevelCounts = new count_t[hullCount];
+	bool* pNextOwned = new bool[hullCount];
+
+	for (int n = 0; n < hullCount; n++)
+	{
+		ppLevel[n] = ppHulls[n];
+		pLevelCounts[n] = (count_t)pCounts[n];
+		pOwned[n] = false;
+	}
+
+	int levelCount = hullCount;
+	while (levelCount > 1)
+	{
+		int pairCount = levelCount / 2;
+		bool isLastLevel = levelCount == 2;
+
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int n = 0; n < pairCount; n++)
+		{
+			count_t count;
+			ppNextLevel[n] = MergeTwoHulls(ppLevel[2 * n], pLevelCounts[2 * n], ppLevel[2 * n + 1], pLevelCounts[2 * n + 1],
+				isLastLevel && closeThePath, count);
+			pNextLevelCounts[n] = count;
+			pNextOwned[n] = true;
+
+			if (pOwned[2 * n])
+			{
+				delete[] ppLevel[2 * n];
+			}
+			if (pOwned[2 * n + 1])
+			{
+				delete[] ppLevel[2 * n + 1];
+			}
+		}
+
+		if (levelCount % 2 == 1) // Odd one goes up as is
+		{
+			ppNextLevel[pairCount] = ppLevel[levelCount - 1];
+			pNextLevelCounts[pairCount] = pLevelCounts[levelCount - 1];
+			pNextOwned[pairCount] = pOwned[levelCount - 1];
+		}
+
+		levelCount = pairCount + levelCount % 2;
+
+		std::swap(ppLevel, ppNextLevel);
+		std::swap(pLevelCounts, pNextLevelCounts);
+		std::swap(pOwned, pNextOwned);
+	}
+
+	point* results = ppLevel[0];
+	resultCount = pLevelCounts[0];
+
+	delete[] ppLevel;
+	delete[] pLevelCounts;
+	delete[] pOwned;
+	delete[] ppNextLevel;
+	delete[] pNextLevelCounts;
+	delete[] pNextOwned;
+
+	return results;
+}
+
+// **************************************************************************
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Point.h"
+
+// Merge of convex polygons, as returned by OuelletHull::GetResultAsArray (counter clockwise from
+// any vertex, closed or not), into the convex hull of their union without going back to the points.
+// Each polygon is split into its lower and upper x monotone chains, chains are merged by x
+// and a single monotone scan keeps the convex part: O(h1 + h2) for two hulls.
+// A polygon with a count of 0 but an array is the GetResultAsArray of points that are all the same:
+// its first point is merged. A NULL polygon is empty.
+// The result is counter clockwise, starting at the rightmost (then highest) vertex and closed if
+// asked (GetResultAsArray doesn't always start there: a single rightmost vertex comes last). It must
+// be freed with delete[].
+
+extern "C"
+{
+	point* mergeHulls(point* pHull1, int64_t count1, point* pHull2, int64_t count2, bool closeThePath, int64_t& resultCount);
+
+	// k-way merge done as a parallel tree reduction (pairs of each level are merged on different threads)
+	point* mergeManyHulls(point** ppHulls, int64_t* pCounts, int hullCount, bool closeThePath, int64_t& resultCount);
+}
@@ -0,0 +1,468 @@
+#include "Stdafx.h"
+#include "HullQuery.h"
+#include <limits>
+#include "CpuFeatures.h"
+
+#pragma managed(push, off)
+
+// **************************************************************************
+// Turn a point of a quadrant into the Q1 frame (90 degrees clockwise per quadrant). Turns keep the
+// orientation: the hull is still on the left of each chain edge.
+static inline void TurnToQ1(int quadrant, const point& pt, double& x, double& y)
+{
+	switch (quadrant)
+	{
+	case 0:
+		x = pt.x;
+		y = pt.y;
+		break;
+	case 1:
+		x = pt.y;
+		y = -pt.x;
+		break;
+	case 2:
+		x = -pt.x;
+		y = -pt.y;
+		break;
+	default:
+		x = -pt.y;
+		y = pt.x;
+		break;
+	}
+}
+
+// **************************************************************************
+HullQuery::HullQuery(const point* pHull, int64_t count)
+{
+	if (count > 1 && compare_points(pHull[0], pHull[count - 1])) // Closed path
+	{
+		count--;
+	}
+
+	for (int quadrant = 0; quadrant < 4; quadrant++)
+	{
+		_chainStart[quadrant] = 0;
+		_chainCount[quadrant] = 0;
+	}
+	_searchStepCount = 0;
+
+	if (count <= 0)
+	{
+		// Nothing is inside an empty box
+		_min.x = _min.y = std::numeric_limits<double>::infinity();
+		_max.x = _max.y = -std::numeric_limits<double>::infinity();
+		for (int quadrant = 0; quadrant < 4; quadrant++)
+		{
+			_root[quadrant] = _min;
+		}
+		_pChainX = new double[1];
+		_pChainY = new double[1];
+		_pChainX[0] = _pChainY[0] = 0;
+		_pChainPoints = new point[1];
+		_pChainPoints[0] = _min;
+		return;
+	}
+
+	// Extremes, with the same tie breaks as OuelletHull: each quadrant chain goes from p1 to p2, counter clockwise
+	count_t q1p1 = 0, q1p2 = 0, q2p1 = 0, q2p2 = 0, q3p1 = 0, q3p2 = 0, q4p1 = 0, q4p2 = 0;
+	for (count_t n = 1; n < count; n++)
+	{
+		const point& pt = pHull[n];
+
+		if (pt.x > pHull[q1p1].x || (pt.x == pHull[q1p1].x && pt.y > pHull[q1p1].y))
+		{
+			q1p1 = n;
+		}
+		if (pt.y > pHull[q1p2].y || (pt.y == pHull[q1p2].y && pt.x > pHull[q1p2].x))
+		{
+			q1p2 = n;
+		}
+		if (pt.y > pHull[q2p1].y || (pt.y == pHull[q2p1].y && pt.x < pHull[q2p1].x))
+		{
+			q2p1 = n;
+		}
+		if (pt.x < pHull[q2p2].x || (pt.x == pHull[q2p2].x && pt.y > pHull[q2p2].y))
+		{
+			q2p2 = n;
+		}
+		if (pt.x < pHull[q3p1].x || (pt.x == pHull[q3p1].x && pt.y < pHull[q3p1].y))
+		{
+			q3p1 = n;
+		}
+		if (pt.y < pHull[q3p2].y || (pt.y == pHull[q3p2].y && pt.x < pHull[q3p2].x))
+		{
+			q3p2 = n;
+		}
+		if (pt.y < pHull[q4p1].y || (pt.y == pHull[q4p1].y && pt.x > pHull[q4p1].x))
+		{
+			q4p1 = n;
+		}
+		if (pt.x > pHull[q4p2].x || (pt.x == pHull[q4p2].x && pt.y < pHull[q4p2].y))
+		{
+			q4p2 = n;
+		}
+	}
+
+	_min.x = pHull[q2p2].x;
+	_min.y = pHull[q3p2].y;
+	_max.x = pHull[q1p1].x;
+	_max.y = pHull[q1p2].y;
+
+	_root[0].x = pHull[q1p2].x;
+	_root[0].y = pHull[q1p1].y;
+	_root[1].x = pHull[q2p1].x;
+	_root[1].y = pHull[q2p2].y;
+	_root[2].x = pHull[q3p2].x;
+	_root[2].y = pHull[q3p1].y;
+	_root[3].x = pHull[q4p1].x;
+	_root[3].y = pHull[q4p2].y;
+
+	count_t first[4] = { q1p1, q2p1, q3p1, q4p1 };
+	count_t last[4] = { q1p2, q2p2, q3p2, q4p2 };
+
+	int64_t total = 0;
+	for (int quadrant = 0; quadrant < 4; quadrant++)
+	{
+		count_t length = last[quadrant] - first[quadrant];
+		if (length < 0)
+		{
+			length += count;
+		}
+
+		_chainStart[quadrant] = total;
+		_chainCount[quadrant] = length + 1;
+		total += length + 1;
+	}
+
+	_pChainX = new double[total + 1];
+	_pChainY = new double[total + 1];
+	_pChainPoints = new point[total];
+
+	int64_t maxEdgeCount = 1;
+	for (int quadrant = 0; quadrant < 4; quadrant++)
+	{
+		count_t index = first[quadrant];
+		for (int64_t n = 0; n < _chainCount[quadrant]; n++)
+		{
+			_pChainPoints[_chainStart[quadrant] + n] = pHull[index];
+			TurnToQ1(quadrant, pHull[index], _pChainX[_chainStart[quadrant] + n], _pChainY[_chainStart[quadrant] + n]);
+			index = (index + 1 == count) ? 0 : index + 1;
+		}
+
+		if (_chainCount[quadrant] - 1 > maxEdgeCount)
+		{
+			maxEdgeCount = _chainCount[quadrant] - 1;
+		}
+	}
+
+	// Spare vertex: "base + 1" of a chain without edge stays readable
+	_pChainX[total] = _pChainX[total - 1];
+	_pChainY[total] = _pChainY[total - 1];
+
+	// Each step turns n edges into ceil(n / 2)
+	while (((int64_t)1 << _searchStepCount) < maxEdgeCount)
+	{
+		_searchStepCount++;
+	}
+}
+
+// **************************************************************************
+HullQuery::~HullQuery()
+{
+	delete[] _pChainX;
+	delete[] _pChainY;
+	delete[] _pChainPoints;
+}
+
+// **************************************************************************
+// (x, y) is already turned in the frame of the quadrant and in its region (y is in the chain range).
+// Branchless binary search of the edge that spans y, then on which side of it the point is.
+bool HullQuery::IsInsideChain(int quadrant, double x, double y) const
+{
+	int64_t base = _chainStart[quadrant];
+	int64_t n = _chainCount[quadrant] - 1;
+	if (n <= 0)
+	{
+		return true; // Empty region
+	}
+
+	while (n > 1)
+	{
+		int64_t half = n >> 1;
+		base = (_pChainY[base + half] <= y) ? base + half : base;
+		n -= half;
+	}
+
+	double ax = _pChainX[base];
+	double ay = _pChainY[base];
+	return (_pChainX[base + 1] - ax) * (y - ay) - (_pChainY[base + 1] - ay) * (x - ax) >= 0;
+}
+
+// **************************************************************************
+bool HullQuery::Contains(const point& pt) const
+{
+	if (pt.x < _min.x || pt.x > _max.x || pt.y < _min.y || pt.y > _max.y || pt.x != pt.x || pt.y != pt.y)
+	{
+		return false;
+	}
+
+	// Q1 and Q2 regions do not overlap, neither do Q3 and Q4. One upper and one lower region can.
+	if (pt.y > _root[0].y && pt.x > _root[0].x)
+	{
+		if (!IsInsideChain(0, pt.x, pt.y))
+		{
+			return false;
+		}
+	}
+	else if (pt.y > _root[1].y && pt.x < _root[1].x)
+	{
+		if (!IsInsideChain(1, pt.y, -pt.x))
+		{
+			return false;
+		}
+	}
+
+	if (pt.y < _root[2].y && pt.x < _root[2].x)
+	{
+		return IsInsideChain(2, -pt.x, -pt.y);
+	}
+	else if (pt.y < _root[3].y && pt.x > _root[3].x)
+	{
+		return IsInsideChain(3, -pt.y, pt.x);
+	}
+
+	return true;
+}
+
+#ifdef HULL_AVX2
+
+// **************************************************************************
+// Same search as IsInsideChain for 4 points, each one with its own chain (start, edge count).
+// Lanes with 0 edge come back as inside.
+static inline __m256d IsInsideChain4(const double* pChainX, const double* pChainY, int searchStepCount,
+	__m256i start, __m256i n, __m256d x, __m256d y)
+{
+	const __m256i one = _mm256_set1_epi64x(1);
+	__m256i base = start;
+	__m256i hasEdge = _mm256_cmpgt_epi64(n, _mm256_setzero_si256());
+
+	for (int step = 0; step < searchStepCount; step++)
+	{
+		__m256i half = _mm256_srli_epi64(n, 1);
+		__m256i probe = _mm256_add_epi64(base, half);
+		__m256d key = _mm256_i64gather_pd(pChainY, probe, 8);
+		__m256d isLower = _mm256_cmp_pd(key, y, _CMP_LE_OQ);
+		base = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(base), _mm256_castsi256_pd(probe), isLower));
+		n = _mm256_sub_epi64(n, half);
+	}
+
+	__m256i next = _mm256_add_epi64(base, one);
+	__m256d ax = _mm256_i64gather_pd(pChainX, base, 8);
+	__m256d ay = _mm256_i64gather_pd(pChainY, base, 8);
+	__m256d bx = _mm256_i64gather_pd(pChainX, next, 8);
+	__m256d by = _mm256_i64gather_pd(pChainY, next, 8);
+
+	__m256d cross = _mm256_sub_pd(
+		_mm256_mul_pd(_mm256_sub_pd(bx, ax), _mm256_sub_pd(y, ay)),
+		_mm256_mul_pd(_mm256_sub_pd(by, ay), _mm256_sub_pd(x, ax)));
+
+	__m256d isInside = _mm256_cmp_pd(cross, _mm256_setzero_pd(), _CMP_GE_OQ);
+	return _mm256_or_pd(isInside, _mm256_castsi256_pd(_mm256_xor_si256(hasEdge, _mm256_set1_epi64x(-1))));
+}
+
+// **************************************************************************
+int64_t HullQuery::ContainsAvx2(const point* pPoints, int64_t count, bool* pResults) const
+{
+	int64_t index = 0;
+
+	const __m256d minX = _mm256_set1_pd(_min.x);
+	const __m256d minY = _mm256_set1_pd(_min.y);
+	const __m256d maxX = _mm256_set1_pd(_max.x);
+	const __m256d maxY = _mm256_set1_pd(_max.y);
+	const __m256d signBit = _mm256_set1_pd(-0.0);
+
+	__m256d rootX[4];
+	__m256d rootY[4];
+	__m256i start[4];
+	__m256i edgeCount[4];
+	for (int quadrant = 0; quadrant < 4; quadrant++)
+	{
+		rootX[quadrant] = _mm256_set1_pd(_root[quadrant].x);
+		rootY[quadrant] = _mm256_set1_pd(_root[quadrant].y);
+		start[quadrant] = _mm256_set1_epi64x(_chainStart[quadrant]);
+		edgeCount[quadrant] = _mm256_set1_epi64x(_chainCount[quadrant] > 0 ? _chainCount[quadrant] - 1 : 0);
+	}
+
+	for (; index + 4 <= count; index += 4)
+	{
+		// (x0, y0, x1, y1) (x2, y2, x3, y3) -> (x0, x1, x2, x3) (y0, y1, y2, y3)
+		__m256d a = _mm256_loadu_pd(&pPoints[index].x);
+		__m256d b = _mm256_loadu_pd(&pPoints[index + 2].x);
+		__m256d x = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xD8);
+		__m256d y = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xD8);
+		__m256d negX = _mm256_xor_pd(x, signBit);
+		__m256d negY = _mm256_xor_pd(y, signBit);
+
+		__m256d isInBox = _mm256_and_pd(
+			_mm256_and_pd(_mm256_cmp_pd(x, minX, _CMP_GE_OQ), _mm256_cmp_pd(x, maxX, _CMP_LE_OQ)),
+			_mm256_and_pd(_mm256_cmp_pd(y, minY, _CMP_GE_OQ), _mm256_cmp_pd(y, maxY, _CMP_LE_OQ)));
+
+		// Upper job: Q1 region, or else Q2 region, turned in the Q1 frame
+		__m256d isInQ1 = _mm256_and_pd(_mm256_cmp_pd(y, rootY[0], _CMP_GT_OQ), _mm256_cmp_pd(x, rootX[0], _CMP_GT_OQ));
+		__m256d isInQ2 = _mm256_and_pd(_mm256_cmp_pd(y, rootY[1], _CMP_GT_OQ), _mm256_cmp_pd(x, rootX[1], _CMP_LT_OQ));
+		__m256i upperStart = _mm256_castpd_si256(_mm256_blendv_pd(
+			_mm256_castsi256_pd(start[1]), _mm256_castsi256_pd(start[0]), isInQ1));
+		__m256i upperCount = _mm256_castpd_si256(_mm256_blendv_pd(
+			_mm256_castsi256_pd(edgeCount[1]), _mm256_castsi256_pd(edgeCount[0]), isInQ1));
+		__m256d isInUpper = _mm256_or_pd(isInQ1, isInQ2);
+		__m256d upper = IsInsideChain4(_pChainX, _pChainY, _searchStepCount, upperStart, upperCount,
+			_mm256_blendv_pd(y, x, isInQ1), _mm256_blendv_pd(negX, y, isInQ1));
+
+		// Lower job: Q3 region, or else Q4 region
+		__m256d isInQ3 = _mm256_and_pd(_mm256_cmp_pd(y, rootY[2], _CMP_LT_OQ), _mm256_cmp_pd(x, rootX[2], _CMP_LT_OQ));
+		__m256d isInQ4 = _mm256_and_pd(_mm256_cmp_pd(y, rootY[3], _CMP_LT_OQ), _mm256_cmp_pd(x, rootX[3], _CMP_GT_OQ));
+		__m256i lowerStart = _mm256_castpd_si256(_mm256_blendv_pd(
+			_mm256_castsi256_pd(start[3]), _mm256_castsi256_pd(start[2]), isInQ3));
+		__m256i lowerCount = _mm256_castpd_si256(_mm256_blendv_pd(
+			_mm256_castsi256_pd(edgeCount[3]), _mm256_castsi256_pd(edgeCount[2]), isInQ3));
+		__m256d isInLower = _mm256_or_pd(isInQ3, isInQ4);
+		__m256d lower = IsInsideChain4(_pChainX, _pChainY, _searchStepCount, lowerStart, lowerCount,
+			_mm256_blendv_pd(negY, negX, isInQ3), _mm256_blendv_pd(x, negY, isInQ3));
+
+		// Inside: in the box, and inside the chain of each region the point is in
+		__m256d isInside = _mm256_and_pd(isInBox,
+			_mm256_and_pd(_mm256_or_pd(_mm256_andnot_pd(isInUpper, isInBox), upper),
+				_mm256_or_pd(_mm256_andnot_pd(isInLower, isInBox), lower)));
+
+		int mask = _mm256_movemask_pd(isInside);
+		pResults[index] = (mask & 1) != 0;
+		pResults[index + 1] = (mask & 2) != 0;
+		pResults[index + 2] = (mask & 4) != 0;
+		pResults[index + 3] = (mask & 8) != 0;
+	}
+
+	return index;
+}
+
+#endif
+
+// **************************************************************************
+void HullQuery::Contains(const point* pPoints, int64_t count, bool* pResults) const
+{
+	int64_t index = 0;
+
+#ifdef HULL_AVX2
+	if (isAvx2Supported())
+	{
+		index = ContainsAvx2(pPoints, count, pResults);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		pResults[index] = Contains(pPoints[index]);
+	}
+}
+
+// **************************************************************************
+// The chain of the quadrant of the direction holds the farthest vertex. Turned in the Q1 frame, the
+// projection of the chain edges on the direction goes from positive to negative: the farthest vertex
+// is after the last edge that goes forward.
+const point& HullQuery::ExtremeVertex(double directionX, double directionY) const
+{
+	int quadrant;
+	if (directionX > 0 && directionY >= 0)
+	{
+		quadrant = 0;
+	}
+	else if (directionX <= 0 && directionY > 0)
+	{
+		quadrant = 1;
+	}
+	else if (directionX < 0 && directionY <= 0)
+	{
+		quadrant = 2;
+	}
+	else
+	{
+		quadrant = 3;
+	}
+
+	point direction = { directionX, directionY };
+	double dx, dy;
+	TurnToQ1(quadrant, direction, dx, dy);
+
+	int64_t base = _chainStart[quadrant];
+	int64_t n = _chainCount[quadrant] - 1;
+	if (n <= 0)
+	{
+		return _pChainPoints[base];
+	}
+
+	while (n > 1)
+	{
+		int64_t half = n >> 1;
+		int64_t edge = base + half;
+		bool isForward = dx * (_pChainX[edge + 1] - _pChainX[edge]) + dy * (_pChainY[edge + 1] - _pChainY[edge]) > 0;
+		base = isForward ? edge : base;
+		n -= half;
+	}
+
+	bool isForward = dx * (_pChainX[base + 1] - _pChainX[base]) + dy * (_pChainY[base + 1] - _pChainY[base]) > 0;
+	return _pChainPoints[isForward ? base + 1 : base];
+}
+
+// **************************************************************************
+bool HullQuery::ExtremePoint(double directionX, double directionY, point& result) const
+{
+	if (_chainCount[0] == 0)
+	{
+		return false;
+	}
+
+	result = ExtremeVertex(directionX, directionY);
+	return true;
+}
+
+// **************************************************************************
+bool HullQuery::ExtremePoints(const point* pDirections, int64_t count, point* pResults) const
+{
+	if (_chainCount[0] == 0)
+	{
+		return false;
+	}
+
+	for (int64_t index = 0; index < count; index++)
+	{
+		pResults[index] = ExtremeVertex(pDirections[index].x, pDirections[index].y);
+	}
+	return true;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
+extern "C" HullQuery* hullQueryCreate(point* pHull, int64_t count)
+{
+	return new HullQuery(pHull, count);
+}
+
+// **************************************************************************
+extern "C" void hullQueryContains(HullQuery* pQuery, point* pPoints, int64_t count, bool* pResults)
+{
+	pQuery->Contains(pPoints, count, pResults);
+}
+
+// **************************************************************************
+extern "C" bool hullQueryExtremePoints(HullQuery* pQuery, point* pDirections, int64_t count, point* pResults)
+{
+	return pQuery->ExtremePoints(pDirections, count, pResults);
+}
+
+// **************************************************************************
+extern "C" void hullQueryDelete(HullQuery* pQuery)
+{
+	delete pQuery;
+}
+
+// **************************************************************************
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Point.h"
+
+// Queries on a convex hull, as returned by OuelletHull::GetResultAsArray (counter clockwise, closed or not).
+//
+// The hull is cut in the same 4 quadrant chains as OuelletHull (Q1 from the rightmost to the topmost
+// vertex, ...). Each chain is stored turned by a multiple of 90 degrees so that all of them go the same way
+// (y increasing): one search code serves the 4 of them. A point is first tested against the bounding box,
+// then against the chain of each quadrant region it is in: at most one of Q1/Q2 and one of Q3/Q4, each one
+// is a binary search over about h/4 vertices.
+// Batches are done 4 points at a time with AVX2 (isAvx2Supported), otherwise with a branchless loop.
+// The farthest vertex in a direction (support function) is in the chain of the quadrant of the direction,
+// where it is found by a binary search on the sign of the edges projection: O(log h).
+class HullQuery
+{
+private:
+	// Chains one after the other, turned, plus one spare vertex at the end
+	double* _pChainX = NULL;
+	double* _pChainY = NULL;
+	int64_t _chainStart[4];
+	int64_t _chainCount[4];
+	point* _pChainPoints = NULL; // Same vertices, not turned
+	int _searchStepCount; // Enough halvings for the longest chain
+
+	point _min; // Bounding box
+	point _max;
+	point _root[4]; // Quadrant roots, as in OuelletHull
+
+	bool IsInsideChain(int quadrant, double x, double y) const;
+	int64_t ContainsAvx2(const point* pPoints, int64_t count, bool* pResults) const; // Returns the count of points done
+	const point& ExtremeVertex(double directionX, double directionY) const;
+
+public:
+	HullQuery(const point* pHull, int64_t count);
+	~HullQuery();
+
+	bool Contains(const point& pt) const; // Inside or on the border
+	void Contains(const point* pPoints, int64_t count, bool* pResults) const;
+
+	// Farthest vertex in a direction, any vertex for a 0 direction. false when the hull is empty.
+	bool ExtremePoint(double directionX, double directionY, point& result) const;
+	bool ExtremePoints(const point* pDirections, int64_t count, point* pResults) const;
+};
+
+extern "C"
+{
+	HullQuery* hullQueryCreate(point* pHull, int64_t count);
+	void hullQueryContains(HullQuery* pQuery, point* pPoints, int64_t count, bool* pResults);
+	bool hullQueryExtremePoints(HullQuery* pQuery, point* pDirections, int64_t count, point* pResults);
+	void hullQueryDelete(HullQuery* pQuery);
+}
@@ -0,0 +1,607 @@
+#include "Stdafx.h"
+#include "HullRegression.h"
+#include "HullBenchmark.h"
+#include "OuelletHull.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Version of the baseline file
+#define HULL_REGRESSION_VERSION 1
+
+// Points of the circle, OuelletHull is O(n + h^2)
+#define HULL_REGRESSION_MAX_CIRCLE_COUNT 20000
+
+// Phases under this part of the total are too short to gate on
+#define HULL_REGRESSION_MIN_PHASE_FRACTION 0.01
+
+#pragma managed(push, off)
+
+static const char* _engineNames[] = { "Ouellet", "Heap", "HeapParallel", "Chan", "ChanParallel", "MonotoneChain",
+	"QuickHull", "DivideAndConquer", "Auto", "OuelletSinglePass" };
+static const char* _distributionNames[] = { "Square", "Disk", "Circle", "Gaussian" };
+static const char* _phaseNames[] = { "Limits", "Search", "Move", "Result" };
+
+// Just what the baseline file needs: null, numbers, strings, arrays and objects (members in file order)
+struct JsonValue
+{
+	enum Type { Null, Number, String, Array, Object };
+
+	Type type = Null;
+	double number = 0;
+	std::string string;
+	std::vector<std::string> names; // Of the members of an object
+	std::vector<JsonValue> items; // Array items or object members
+
+	// **************************************************************************
+	JsonValue* Member(const std::string& name)
+	{
+		for (size_t n = 0; n < names.size(); n++)
+		{
+			if (names[n] == name)
+			{
+				return &items[n];
+			}
+		}
+		return NULL;
+	}
+
+	// **************************************************************************
+	// Added when missing
+	JsonValue& SetMember(const std::string& name, Type memberType)
+	{
+		JsonValue* pMember = Member(name);
+		if (pMember == NULL)
+		{
+			names.push_back(name);
+			items.push_back(JsonValue());
+			pMember = &items.back();
+		}
+		if (pMember->type != memberType)
+		{
+			*pMember = JsonValue();
+			pMember->type = memberType;
+		}
+		return *pMember;
+	}
+};
+
+// **************************************************************************
+static void SkipSpaces(const char*& p)
+{
+	while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+	{
+		p++;
+	}
+}
+
+// **************************************************************************
+// Escapes other than \" \\ \/ \n \r \t are read as '?'
+static bool ParseJsonString(const char*& p, std::string& value)
+{
+	if (*p != '"')
+	{
+		return false;
+	}
+	p++;
+
+	value.clear();
+	while (*p != '"')
+	{
+		if (*p == 0)
+		{
+			return false;
+		}
+		if (*p == '\\')
+		{
+			p++;
+			switch (*p)
+			{
+			case '"': case '\\': case '/': value += *p; break;
+			case 'n': value += '\n'; break;
+			case 'r': value += '\r'; break;
+			case 't': value += '\t'; break;
+			case 0: return false;
+			default: value += '?'; break;
+			}
+			p++;
+			continue;
+		}
+		value += *p++;
+	}
+	p++;
+	return true;
+}
+
+// **************************************************************************
+static bool ParseJson(const char*& p, JsonValue& value)
+{
+	SkipSpaces(p);
+	value = JsonValue();
+
+	if (*p == '{')
+	{
+		value.type = JsonValue::Object;
+		p++;
+		SkipSpaces(p);
+		if (*p == '}')
+		{
+			p++;
+			return true;
+		}
+		for (;;)
+		{
+			SkipSpaces(p);
+			std::string name;
+			if (!ParseJsonString(p, name))
+			{
+				return false;
+			}
+			SkipSpaces(p);
+			if (*p++ != ':')
+			{
+				return false;
+			}
+			value.names.push_back(name);
+			value.items.push_back(JsonValue());
+			if (!ParseJson(p, value.items.back()))
+			{
+				return false;
+			}
+			SkipSpaces(p);
+			if (*p == '}')
+			{
+				p++;
+				return true;
+			}
+			if (*p++ != ',')
+			{
+				return false;
+			}
+		}
+	}
+
+	if (*p == '[')
+	{
+		value.type = JsonValue::Array;
+		p++;
+		SkipSpaces(p);
+		if (*p == ']')
+		{
+			p++;
+			return true;
+		}
+		for (;;)
+		{
+			value.items.push_back(JsonValue());
+			if (!ParseJson(p, value.items.back()))
+			{
+				return false;
+			}
+			SkipSpaces(p);
+			if (*p == ']')
+			{
+				p++;
+				return true;
+			}
+			if (*p++ != ',')
+			{
+				return false;
+			}
+		}
+	}
+
+	if (*p == '"')
+	{
+		value.type = JsonValue::String;
+		return ParseJsonString(p, value.string);
+	}
+
+	if (strncmp(p, "null", 4) == 0)
+	{
+		p += 4;
+		return true;
+	}
+
+	char* pEnd;
+	value.number = strtod(p, &pEnd);
+	if (pEnd == p)
+	{
+		return false;
+	}
+	value.type = JsonValue::Number;
+	p = pEnd;
+	return true;
+}
+
+// **************************************************************************
+static void WriteJsonString(std::string& out, const std::string& value)
+{
+	out += '"';
+	for (char c : value)
+	{
+		switch (c)
+		{
+		case '"': out += "\\\""; break;
+		case '\\': out += "\\\\"; break;
+		case '\n': out += "\\n"; break;
+		case '\r': out += "\\r"; break;
+		case '\t': out += "\\t"; break;
+		default: out += (unsigned char)c < 0x20 ? '?' : c; break;
+		}
+	}
+	out += '"';
+}
+
+// **************************************************************************
+// Objects one member by line, arrays on one line (the samples)
+static void WriteJson(std::string& out, const JsonValue& value, int depth)
+{
+	char buffer[32];
+	switch (value.type)
+	{
+	case JsonValue::Null:
+		out += "null";
+		break;
+	case JsonValue::Number:
+		snprintf(buffer, sizeof(buffer), "%.17g", value.number);
+		out += buffer;
+		break;
+	case JsonValue::String:
+		WriteJsonString(out, value.string);
+		break;
+	case JsonValue::Array:
+		out += '[';
+		for (size_t n = 0; n < value.items.size(); n++)
+		{
+			out += n > 0 ? ", " : "";
+			WriteJson(out, value.items[n], depth + 1);
+		}
+		out += ']';
+		break;
+	case JsonValue::Object:
+		out += '{';
+		for (size_t n = 0; n < value.items.size(); n++)
+		{
+			out += n > 0 ? ",\n" : "\n";
+			out.append(depth + 1, '\t');
+			WriteJsonString(out, value.names[n]);
+			out += ": ";
+			WriteJson(out, value.items[n], depth + 1);
+		}
+		if (!value.items.empty())
+		{
+			out += '\n';
+			out.append(depth, '\t');
+		}
+		out += '}';
+		break;
+	}
+}
+
+// **************************************************************************
+static std::string MachineName()
+{
+#ifdef _WIN32
+	char name[MAX_COMPUTERNAME_LENGTH + 1];
+	DWORD size = sizeof(name);
+	if (GetComputerNameA(name, &size))
+	{
+		return name;
+	}
+#else
+	char name[256];
+	if (gethostname(name, sizeof(name)) == 0)
+	{
+		name[sizeof(name) - 1] = 0;
+		return name;
+	}
+#endif
+	return "default";
+}
+
+// **************************************************************************
+static std::vector<point> GeneratePoints(int distribution, int64_t count)
+{
+	std::mt19937_64 random(12345 + distribution);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	std::vector<point> points((size_t)count);
+	for (auto& pt : points)
+	{
+		switch (distribution)
+		{
+		case HullDistributionSquare:
+			pt.x = uniform(random);
+			pt.y = uniform(random);
+			break;
+		case HullDistributionDisk:
+		{
+			double angle = uniform(random) * 6.283185307179586;
+			double radius = sqrt(uniform(random));
+			pt.x = radius * cos(angle);
+			pt.y = radius * sin(angle);
+			break;
+		}
+		case HullDistributionCircle:
+		{
+			double angle = uniform(random) * 6.283185307179586;
+			pt.x = cos(angle);
+			pt.y = sin(angle);
+			break;
+		}
+		default:
+			pt.x = normal(random);
+			pt.y = normal(random);
+			break;
+		}
+	}
+	return points;
+}
+
+// **************************************************************************
+static double Median(std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+	size_t count = values.size();
+	return count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+// **************************************************************************
+// One sided Mann-Whitney U test: probability of samples at least this much larger than the baseline ones if
+// they were not. Normal approximation, ties get their mean rank.
+static double MannWhitneyPValue(const std::vector<double>& baseline, const std::vector<double>& samples)
+{
+	std::vector<std::pair<double, bool>> all; // Value, is of samples
+	for (double value : baseline)
+	{
+		all.push_back(std::make_pair(value, false));
+	}
+	for (double value : samples)
+	{
+		all.push_back(std::make_pair(value, true));
+	}
+	std::sort(all.begin(), all.end());
+
+	double rankSum = 0;
+	for (size_t n = 0; n < all.size();)
+	{
+		size_t end = n + 1;
+		while (end < all.size() && all[end].first == all[n].first)
+		{
+			end++;
+		}
+		double rank = (n + 1 + end) / 2.0;
+		for (size_t k = n; k < end; k++)
+		{
+			rankSum += all[k].second ? rank : 0;
+		}
+		n = end;
+	}
+
+	double n1 = (double)samples.size();
+	double n2 = (double)baseline.size();
+	double u = rankSum - n1 * (n1 + 1) / 2;
+	double z = (u - n1 * n2 / 2 - 0.5) / sqrt(n1 * n2 * (n1 + n2 + 1) / 12);
+	return 0.5 * erfc(z / sqrt(2.0));
+}
+
+// **************************************************************************
+static std::vector<double> ToSamples(const JsonValue* pValue)
+{
+	std::vector<double> samples;
+	if (pValue != NULL && pValue->type == JsonValue::Array)
+	{
+		for (const JsonValue& item : pValue->items)
+		{
+			if (item.type == JsonValue::Number)
+			{
+				samples.push_back(item.number);
+			}
+		}
+	}
+	return samples;
+}
+
+// **************************************************************************
+static JsonValue ToJson(const std::vector<double>& samples)
+{
+	JsonValue value;
+	value.type = JsonValue::Array;
+	for (double sample : samples)
+	{
+		JsonValue item;
+		item.type = JsonValue::Number;
+		item.number = sample;
+		value.items.push_back(item);
+	}
+	return value;
+}
+
+// **************************************************************************
+// Adds the line of the comparison to report, returns true for a regression
+static bool Compare(const std::string& name, const std::vector<double>& baseline, const std::vector<double>& samples,
+	bool isGated, const HullRegressionOptions& options, std::string& report)
+{
+	char line[256];
+	double median = Median(samples);
+	if (baseline.empty())
+	{
+		snprintf(line, sizeof(line), "%s: %.3f ms, no baseline\n", name.c_str(), median * 1e3);
+		report += line;
+		return false;
+	}
+
+	// Against the baseline slowed down by threshold: what is significant is a slowdown above it
+	std::vector<double> slowedBaseline(baseline);
+	for (double& value : slowedBaseline)
+	{
+		value *= 1 + options.threshold;
+	}
+	double pValue = MannWhitneyPValue(slowedBaseline, samples);
+	double baselineMedian = Median(baseline);
+	bool isRegression = isGated && pValue < 1 - options.confidence;
+
+	snprintf(line, sizeof(line), "%s: %.3f ms -> %.3f ms (%+.1f%%), p %.4f%s\n", name.c_str(), baselineMedian * 1e3,
+		median * 1e3, baselineMedian > 0 ? (median / baselineMedian - 1) * 100 : 0.0, pValue,
+		isRegression ? " REGRESSION" : isGated ? "" : " (not gated)");
+	report += line;
+	return isRegression;
+}
+
+// **************************************************************************
+extern "C" int hullRegressionGate(const HullRegressionOptions& options, char** ppReport)
+{
+	std::string report;
+	int status = HullRegressionPassed;
+
+	JsonValue root;
+	root.type = JsonValue::Object;
+	std::ifstream input(options.baselinePath, std::ios::binary);
+	if (input)
+	{
+		std::stringstream text;
+		text << input.rdbuf();
+		std::string content = text.str();
+		const char* p = content.c_str();
+		JsonValue* pVersion = NULL;
+		if (!ParseJson(p, root) || root.type != JsonValue::Object || (pVersion = root.Member("version")) == NULL ||
+			pVersion->type != JsonValue::Number || pVersion->number != HULL_REGRESSION_VERSION)
+		{
+			report += std::string(options.baselinePath) + ": not a baseline file of version " +
+				std::to_string(HULL_REGRESSION_VERSION) + "\n";
+			status = HullRegressionError;
+		}
+	}
+
+	if (status != HullRegressionError)
+	{
+		std::string machine = options.machine != NULL ? options.machine : MachineName();
+		root.SetMember("version", JsonValue::Number).number = HULL_REGRESSION_VERSION;
+		JsonValue& machineBaselines = root.SetMember("machines", JsonValue::Object).SetMember(machine, JsonValue::Object);
+
+		char line[256];
+		snprintf(line, sizeof(line), "Machine %s, threshold %.1f%%, confidence %.1f%%\n", machine.c_str(),
+			options.threshold * 100, options.confidence * 100);
+		report += line;
+
+		HullBenchmarkOptions benchmarkOptions;
+		benchmarkOptions.warmupCount = options.warmupCount;
+		benchmarkOptions.iterationCount = std::max(options.iterationCount, 1);
+		benchmarkOptions.pinThreads = false;
+
+		for (int distribution = 0; distribution < HullDistributionCount; distribution++)
+		{
+			if (options.distributionMask != 0 && !(options.distributionMask & (1u << distribution)))
+			{
+				continue;
+			}
+
+			int64_t count = distribution == HullDistributionCircle ?
+				std::min(options.pointCount, (int64_t)HULL_REGRESSION_MAX_CIRCLE_COUNT) : options.pointCount;
+			std::vector<point> points = GeneratePoints(distribution, count);
+
+			for (int engine = HullBenchmarkOuellet; engine < HullBenchmarkEngineCount; engine++)
+			{
+				if (options.engineMask != 0 && !(options.engineMask & (1u << engine)))
+				{
+					continue;
+				}
+
+				std::string name = std::string(_engineNames[engine]) + "/" + _distributionNames[distribution] + "/" +
+					std::to_string(count);
+				JsonValue* pBaseline = machineBaselines.Member(name);
+
+				HullBenchmarkResult result;
+				std::vector<double> samples(benchmarkOptions.iterationCount);
+				hullBenchmark(engine, points.data(), count, benchmarkOptions, result, samples.data());
+
+				std::vector<double> baseline = ToSamples(pBaseline != NULL ? pBaseline->Member("total") : NULL);
+				if (Compare(name, baseline, samples, true, options, report))
+				{
+					status = HullRegressionFailed;
+				}
+
+				JsonValue caseBaseline;
+				caseBaseline.type = JsonValue::Object;
+				caseBaseline.SetMember("total", JsonValue::Array) = ToJson(samples);
+
+				if (engine == HullBenchmarkOuellet)
+				{
+					std::vector<double> phaseSeconds(benchmarkOptions.iterationCount * OuelletHullPhaseCount);
+					hullBenchmarkPhases(points.data(), count, benchmarkOptions, phaseSeconds.data());
+
+					double baselineMedian = baseline.empty() ? Median(samples) : Median(baseline);
+					for (int phase = 0; phase < OuelletHullPhaseCount; phase++)
+					{
+						std::vector<double> phaseSamples;
+						for (int run = 0; run < benchmarkOptions.iterationCount; run++)
+						{
+							phaseSamples.push_back(phaseSeconds[run * OuelletHullPhaseCount + phase]);
+						}
+
+						std::vector<double> phaseBaseline = ToSamples(pBaseline != NULL ? pBaseline->Member(_phaseNames[phase]) : NULL);
+						bool isGated = !phaseBaseline.empty() &&
+							Median(phaseBaseline) >= HULL_REGRESSION_MIN_PHASE_FRACTION * baselineMedian;
+						if (Compare("  " + std::string(_phaseNames[phase]), phaseBaseline, phaseSamples, isGated, options, report))
+						{
+							status = HullRegressionFailed;
+						}
+
+						caseBaseline.SetMember(_phaseNames[phase], JsonValue::Array) = ToJson(phaseSamples);
+					}
+				}
+
+				if (options.updateBaseline)
+				{
+					machineBaselines.SetMember(name, JsonValue::Object) = caseBaseline;
+				}
+			}
+		}
+
+		if (options.updateBaseline)
+		{
+			std::string text;
+			WriteJson(text, root, 0);
+			text += '\n';
+
+			std::ofstream output(options.baselinePath, std::ios::binary);
+			output << text;
+			if (!output)
+			{
+				report += std::string(options.baselinePath) + ": can't be written\n";
+				status = HullRegressionError;
+			}
+			else
+			{
+				report += "Baselines of " + machine + " updated\n";
+			}
+		}
+	}
+
+	if (ppReport != NULL)
+	{
+		*ppReport = new char[report.size() + 1];
+		memcpy(*ppReport, report.c_str(), report.size() + 1);
+	}
+	return status;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
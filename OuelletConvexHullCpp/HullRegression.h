@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Point.h"
+
+// Point sets of hullRegressionGate
+enum HullDistribution
+{
+	HullDistributionSquare = 0, // Uniform in a square: few hull points
+	HullDistributionDisk = 1, // Uniform in a disk: about n^(1/3) hull points
+	HullDistributionCircle = 2, // On a circle: all points on the hull
+	HullDistributionGaussian = 3, // Normal: about sqrt(log n) hull points
+	HullDistributionCount = 4,
+};
+
+struct HullRegressionOptions
+{
+	const char* baselinePath; // Versioned JSON file of the baselines, created by the first updateBaseline
+	const char* machine; // Key of the baselines, NULL: the computer name
+	unsigned engineMask; // Bit by HullBenchmarkEngine, 0: all
+	unsigned distributionMask; // Bit by HullDistribution, 0: all
+	int64_t pointCount; // At most 20000 for the circle (OuelletHull is quadratic on it)
+	int warmupCount;
+	int iterationCount; // Samples of each case, 10 or more for the test to have some power
+	double threshold; // Slowdown tolerated, ex: 0.05 for 5%
+	double confidence; // Ex: 0.99
+	bool updateBaseline; // The samples of this run become the baselines of their cases (for this machine)
+};
+
+// Status of hullRegressionGate
+enum HullRegressionStatus
+{
+	HullRegressionPassed = 0,
+	HullRegressionFailed = 1, // A case or a phase is slower than threshold, with confidence
+	HullRegressionError = 2, // Baseline file can't be read (bad JSON or version) or written
+};
+
+// Performance regression gate of the native engines: every engine of engineMask runs on every distribution of
+// distributionMask (hullBenchmark, fixed seeds), and its samples are compared to the baseline samples of the
+// same machine, distribution and point count. OuelletHull is also compared phase by phase (hullBenchmarkPhases),
+// so a slower limits scan is not hidden by the quadrant pass. Phases under 1% of the total are reported only.
+//
+// A case fails when a one sided Mann-Whitney test says its times are larger than the baseline times slowed down
+// by threshold, at confidence: noise of a few runs doesn't fail it, a real slowdown does with enough samples.
+// Cases without baseline pass.
+//
+// File: { "version": 1, "machines": { machine: { "engine/distribution/count": { "total": [seconds...],
+// phase: [seconds...] } } } }. Other machines and cases are kept when it is updated.
+extern "C"
+{
+	// ppReport: NULL or text of the comparisons, a line by case and phase. Free with delete[].
+	int hullRegressionGate(const HullRegressionOptions& options, char** ppReport);
+}
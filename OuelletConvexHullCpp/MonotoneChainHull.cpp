@@ -0,0 +1,237 @@
+#include "Stdafx.h"
+#include "MonotoneChainHull.h"
+#include <string.h>
+#include <algorithm>
+#include <omp.h>
+
+// Below, std::sort is faster than the passes of the radix sort
+#define RADIX_SORT_MIN_COUNT 4096
+
+// Points per thread of the radix sort, fewer threads are used on small inputs
+#define RADIX_SORT_THREAD_SIZE 65536
+
+// Digit of a radix sort pass: 6 passes, counts of all threads stay in cache
+#define RADIX_SORT_BITS 11
+#define RADIX_SORT_DIGITS (1 << RADIX_SORT_BITS)
+
+#pragma managed(push, off)
+
+// **************************************************************************
+// Order preserving: the sign bit of positive numbers is flipped, all bits of negative ones. -0 is made 0 first.
+static inline uint64_t SortKey(double value)
+{
+	value += 0.0;
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits ^ ((uint64_t)((int64_t)bits >> 63) | 0x8000000000000000ull);
+}
+
+// **************************************************************************
+static inline double SortKeyValue(uint64_t key)
+{
+	uint64_t bits = key ^ (((key >> 63) - 1) | 0x8000000000000000ull);
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// What the radix sort moves: x is given back by its key
+struct SortItem
+{
+	uint64_t key;
+	double y;
+};
+
+// **************************************************************************
+extern "C" bool isSortedPoints(const point* pPoints, int64_t count, bool isDescending)
+{
+	int order = isDescending ? -1 : 1;
+	for (count_t n = 1; n < count; n++)
+	{
+		if (order * cmp(pPoints[n - 1], pPoints[n]) > 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// **************************************************************************
+extern "C" void radixSortPoints(point* pPoints, int64_t count)
+{
+	if (count < RADIX_SORT_MIN_COUNT)
+	{
+		std::sort(pPoints, pPoints + count, [](const point& a, const point& b) { return cmp(a, b) < 0; });
+		return;
+	}
+
+	int threadCount = std::min(omp_get_max_threads(), (int)(count / RADIX_SORT_THREAD_SIZE) + 1);
+	count_t* pCounts = new count_t[RADIX_SORT_DIGITS * threadCount]; // Of each digit by thread, then where the thread writes it
+
+	// Passes go back and forth between both halves
+	SortItem* pBuffer = new SortItem[2 * count];
+	SortItem* pIn = pBuffer;
+	SortItem* pOut = pBuffer + count;
+
+	uint64_t firstKey = SortKey(pPoints[0].x);
+	uint64_t varyingBits = 0; // Bits that are not the same in all keys
+
+#pragma omp parallel num_threads(threadCount)
+	{
+		int thread = omp_get_thread_num();
+		int threads = omp_get_num_threads();
+		count_t begin = (count_t)(count * thread / threads);
+		count_t end = (count_t)(count * (thread + 1) / threads);
+
+		uint64_t threadVaryingBits = 0;
+		for (count_t n = begin; n < end; n++)
+		{
+			pIn[n].key = SortKey(pPoints[n].x);
+			pIn[n].y = pPoints[n].y;
+			threadVaryingBits |= pIn[n].key ^ firstKey;
+		}
+
+#pragma omp critical
+		varyingBits |= threadVaryingBits;
+#pragma omp barrier
+
+		count_t* pThreadCounts = pCounts + RADIX_SORT_DIGITS * thread;
+		for (int shift = 0; shift < 64; shift += RADIX_SORT_BITS)
+		{
+			if (((varyingBits >> shift) & (RADIX_SORT_DIGITS - 1)) == 0)
+			{
+				continue;
+			}
+
+			memset(pThreadCounts, 0, RADIX_SORT_DIGITS * sizeof(count_t));
+			for (count_t n = begin; n < end; n++)
+			{
+				pThreadCounts[(pIn[n].key >> shift) & (RADIX_SORT_DIGITS - 1)]++;
+			}
+
+#pragma omp barrier
+#pragma omp single
+			{
+				// Digit by digit, threads in order: stable
+				count_t offset = 0;
+				for (int digit = 0; digit < RADIX_SORT_DIGITS; digit++)
+				{
+					for (int t = 0; t < threads; t++)
+					{
+						count_t digitCount = pCounts[RADIX_SORT_DIGITS * t + digit];
+						pCounts[RADIX_SORT_DIGITS * t + digit] = offset;
+						offset += digitCount;
+					}
+				}
+			}
+
+			for (count_t n = begin; n < end; n++)
+			{
+				pOut[pThreadCounts[(pIn[n].key >> shift) & (RADIX_SORT_DIGITS - 1)]++] = pIn[n];
+			}
+
+#pragma omp barrier
+#pragma omp single
+			{
+				std::swap(pIn, pOut);
+			}
+		}
+
+		for (count_t n = begin; n < end; n++)
+		{
+			pPoints[n].x = SortKeyValue(pIn[n].key);
+			pPoints[n].y = pIn[n].y;
+		}
+	}
+
+	delete[] pBuffer;
+	delete[] pCounts;
+
+	// Equal x, by y
+	for (count_t n = 0; n < count;)
+	{
+		count_t end = n + 1;
+		while (end < count && pPoints[end].x == pPoints[n].x)
+		{
+			end++;
+		}
+		if (end - n > 1)
+		{
+			std::sort(pPoints + n, pPoints + end, [](const point& a, const point& b) { return a.y < b.y; });
+		}
+		n = end;
+	}
+}
+
+// **************************************************************************
+extern "C" point* sortedMonotoneChainHull(const point* pPoints, int64_t count, bool isDescending, bool closeThePath, int64_t& resultCount)
+{
+	point* pHull = new point[count + 2];
+	count_t k = 0;
+
+	// Upper chain from the rightmost (then highest) point to the leftmost (then lowest): counter clockwise
+	for (count_t n = (count_t)count - 1; n >= 0; n--)
+	{
+		const point& pt = pPoints[isDescending ? count - 1 - n : n];
+		if (k > 0 && compare_points(pHull[k - 1], pt))
+		{
+			continue;
+		}
+		while (k >= 2 && area(pHull[k - 2], pHull[k - 1], pt) <= 0)
+		{
+			k--;
+		}
+		pHull[k++] = pt;
+	}
+
+	// Lower chain back to the first vertex
+	count_t upperCount = k;
+	for (count_t n = 1; n < count; n++)
+	{
+		const point& pt = pPoints[isDescending ? count - 1 - n : n];
+		if (compare_points(pHull[k - 1], pt))
+		{
+			continue;
+		}
+		while (k > upperCount && area(pHull[k - 2], pHull[k - 1], pt) <= 0)
+		{
+			k--;
+		}
+		pHull[k++] = pt;
+	}
+
+	// The first vertex is at the end once there are 2 of them
+	resultCount = k > 1 ? k - 1 : k;
+	if (closeThePath && resultCount > 0)
+	{
+		pHull[resultCount] = pHull[0];
+		resultCount++;
+	}
+
+	return pHull;
+}
+
+// **************************************************************************
+extern "C" point* monotoneChainHull(point* pPoints, int64_t count, bool closeThePath, int64_t& resultCount)
+{
+	if (isSortedPoints(pPoints, count, false))
+	{
+		return sortedMonotoneChainHull(pPoints, count, false, closeThePath, resultCount);
+	}
+	if (isSortedPoints(pPoints, count, true))
+	{
+		return sortedMonotoneChainHull(pPoints, count, true, closeThePath, resultCount);
+	}
+
+	point* pSorted = new point[count];
+	memcpy(pSorted, pPoints, count * sizeof(point));
+	radixSortPoints(pSorted, count);
+
+	point* results = sortedMonotoneChainHull(pSorted, count, false, closeThePath, resultCount);
+	delete[] pSorted;
+	return results;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Point.h"
+
+// Andrew's monotone chain: points sorted by x then y, then one linear scan. O(n) after the sort whatever the
+// hull size, where OuelletHull gets quadratic when most points are on the hull (InsertPoint moves).
+//
+// The sort is an LSD radix sort (11 bits per pass, 6 passes) of x mapped to an order preserving 64 bits key,
+// done on all threads: each thread counts the digits of its part, then writes them at its offsets (stable).
+// Passes where all keys have the same digit are skipped (sign and exponent bits of points in a small range).
+// Runs of equal x are then sorted by y. Input already sorted by x then y (ascending or descending) is detected
+// and not sorted.
+//
+// The result has the layout of mergeHulls: counter clockwise, starting at the rightmost (then highest)
+// vertex, closed if asked. The input is not modified. Free with delete[].
+extern "C"
+{
+	point* monotoneChainHull(point* pPoints, int64_t count, bool closeThePath, int64_t& resultCount);
+
+	// Scan only: pPoints must be sorted by x then y, ascending or descending (isDescending).
+	point* sortedMonotoneChainHull(const point* pPoints, int64_t count, bool isDescending, bool closeThePath, int64_t& resultCount);
+
+	// Sorts pPoints by x then y, in place
+	void radixSortPoints(point* pPoints, int64_t count);
+
+	// pPoints is sorted by x then y, ascending or descending (isDescending)
+	bool isSortedPoints(const point* pPoints, int64_t count, bool isDescending);
+}
@@ -1,40 +1,61 @@
 #include "Stdafx.h"
 #include "OuelletHull.h"
+#include "OuelletHullOf.h"
+#include "HullBenchmark.h"
+#include "HullRegression.h"
+#include "ParallelHull.h"
+#include "MonotoneChainHull.h"
+#include "AutoHull.h"
 #include "Point.h"
 #include <string.h>
 #include <omp.h>
 
+template class OuelletHullOf<point>;
+template class OuelletHullOf<pointWithId>;
+
 using namespace System::Windows;
 
 // **************************************************************************
-array<Point>^ OuelletConvexHullCpp::OuelletHullManaged(array<Point>^ points, bool closeThePath)
+// System::Windows::Point is 2 doubles, like point: managed arrays are pinned and used as point arrays
+static void CopyToManaged(const point* pPoints, int64_t count, array<Point>^ points)
 {
-	// point* pArrayOfPoint, int count
-	
-	int count = points->Length;
-	point* pArrayOfPoint = new point[count];
-	for (int n = count - 1; n >= 0; n--)
+	if (count > 0)
 	{
-		pArrayOfPoint[n].x = points[n].X;
-		pArrayOfPoint[n].y = points[n].Y;
+		pin_ptr<Point> pPinnedPoints = &points[0];
+		Point* pManagedPoints = pPinnedPoints;
+		memcpy(pManagedPoints, pPoints, (size_t)count * sizeof(point));
+	}
+}
+
+// **************************************************************************
+// The engine reads the pinned managed points, no copy
+static point* OuelletHullPinned(array<Point>^ points, bool closeThePath, int64_t& resultCount)
+{
+	resultCount = 0;
+	if (points->Length == 0)
+	{
+		return NULL;
 	}
 
-	int resultCount;
-	point* result = ouelletHull(pArrayOfPoint, count, closeThePath, resultCount);
+	pin_ptr<Point> pPinnedPoints = &points[0];
+	Point* pPoints = pPinnedPoints;
+	return ouelletHull64(reinterpret_cast<point*>(pPoints), points->Length, closeThePath, resultCount);
+}
+
+// **************************************************************************
+array<Point>^ OuelletConvexHullCpp::OuelletHullManaged(array<Point>^ points, bool closeThePath)
+{
+	int64_t resultCount;
+	point* result = OuelletHullPinned(points, closeThePath, resultCount);
 
 	array<Point>^ resultManaged = nullptr;
 	if (resultCount > 0)
 	{
-		resultManaged = gcnew array<Point>(resultCount);
-		for (int n = 0; n < resultCount; n++)
-		{
-			resultManaged[n].X = result[n].x;
-			resultManaged[n].Y = result[n].y;
-		}
+		resultManaged = gcnew array<Point>((int)resultCount);
+		CopyToManaged(result, resultCount, resultManaged);
 	}
 
-	delete pArrayOfPoint;
-	delete result;
+	delete[] result;
 
 	return resultManaged;
 }
@@ -42,860 +63,287 @@ array<Point>^ OuelletConvexHullCpp::OuelletHullManaged(array<Point>^ points, boo
 // **************************************************************************
 array<Point>^ OuelletConvexHullCpp::OuelletHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath, double% elapsedTimeInSec)
 {
-	// point* pArrayOfPoint, int count
-	
-	int count = points->Length;
-	point* pArrayOfPoint = new point[count];
-	for (int n = count - 1; n >= 0; n--)
+	int64_t resultCount = 0;
+	point* result = NULL;
+	elapsedTimeInSec = 0;
+	if (points->Length > 0)
 	{
-		pArrayOfPoint[n].x = points[n].X;
-		pArrayOfPoint[n].y = points[n].Y;
+		pin_ptr<Point> pPinnedPoints = &points[0];
+		Point* pPoints = pPinnedPoints;
+		double hullTimeStart = omp_get_wtime();
+		result = ouelletHull64(reinterpret_cast<point*>(pPoints), points->Length, closeThePath, resultCount);
+		elapsedTimeInSec = omp_get_wtime() - hullTimeStart;
 	}
 
-	double timeStart = omp_get_wtime();
-
-	int resultCount;
-	point* result = ouelletHull(pArrayOfPoint, count, closeThePath, resultCount);
+	array<Point>^ resultManaged = gcnew array<Point>((int)resultCount);
+	CopyToManaged(result, resultCount, resultManaged);
 
-	elapsedTimeInSec = omp_get_wtime() - timeStart;
+	delete[] result;
 
-	array<Point>^ resultManaged = nullptr;
-	if (resultCount >= 0)
-	{
-		resultManaged = gcnew array<Point>(resultCount);
-		for (int n = 0; n < resultCount; n++)
-		{
-			resultManaged[n].X = result[n].x;
-			resultManaged[n].Y = result[n].y;
-		}
-	}
-	
-	delete pArrayOfPoint;
-	delete result;
-	
 	return resultManaged;
 }
 
 // **************************************************************************
-extern "C" point* ouelletHull(point* pArrayOfPoint, int count, bool closeThePath, int& resultCount)
-{
-	OuelletHull convexHull(pArrayOfPoint, count, closeThePath);
-	return convexHull.GetResultAsArray(resultCount);
-}
-
-// **************************************************************************
-int ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int count)
-{
-	int resultCount;
-	OuelletHull convexHull(pArrayOfPoint, count, true);
-	convexHull.GetResultAsArray(resultCount);
-	return resultCount;
-}
-
-// **************************************************************************
-void OuelletHull::CalcConvexHull()
+array<Point>^ OuelletConvexHullCpp::OuelletHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath, double% elapsedTimeInSec,
+	double% savedTimeInSec)
 {
-	// Find the quadrant limits (maximum x and y)
-	point* pPt = _pPoints;
-
-	point q1p1 = *pPt;
-	point q1p2 = *pPt;
-	point q2p1 = *pPt;
-	point q2p2 = *pPt;
-	point q3p1 = *pPt;
-	point q3p2 = *pPt;
-	point q4p1 = *pPt;
-	point q4p2 = *pPt;
-
-	pPt++;
+	double timeStart = omp_get_wtime();
 
-	for (int n = _countOfPoint - 1; n > 0; n--) // -1 because 0 bound.
+	int64_t resultCount = 0;
+	point* result = NULL;
+	elapsedTimeInSec = 0;
+	if (points->Length > 0)
 	{
-		point& pt = *pPt;
-
-		// Right
-		if (pt.x >= q1p1.x)
-		{
-			if (pt.x == q1p1.x)
-			{
-				if (pt.y > q1p1.y)
-				{
-					q1p1 = pt;
-				}
-				else
-				{
-					if (pt.y < q4p2.y)
-					{
-						q4p2 = pt;
-					}
-				}
-			}
-			else
-			{
-				q1p1 = pt;
-				q4p2 = pt;
-			}
-		}
-
-		// Left
-		if (pt.x <= q2p2.x)
-		{
-			if (pt.x == q2p2.x)
-			{
-				if (pt.y > q2p2.y)
-				{
-					q2p2 = pt;
-				}
-				else
-				{
-					if (pt.y < q3p1.y)
-					{
-						q3p1 = pt;
-					}
-				}
-			}
-			else
-			{
-				q2p2 = pt;
-				q3p1 = pt;
-			}
-		}
-
-		// Top
-		if (pt.y >= q1p2.y)
-		{
-			if (pt.y == q1p2.y)
-			{
-				if (pt.x < q2p1.x)
-				{
-					q2p1 = pt;
-				}
-				else
-				{
-					if (pt.x > q1p2.x)
-					{
-						q1p2 = pt;
-					}
-				}
-			}
-			else
-			{
-				q1p2 = pt;
-				q2p1 = pt;
-			}
-		}
-
-		// Bottom
-		if (pt.y <= q3p2.y)
-		{
-			if (pt.y == q3p2.y)
-			{
-				if (pt.x < q3p2.x)
-				{
-					q3p2 = pt;
-				}
-				else
-				{
-					if (pt.x > q4p1.x)
-					{
-						q4p1 = pt;
-					}
-				}
-			}
-			else
-			{
-				q3p2 = pt;
-				q4p1 = pt;
-			}
-		}
-
-		pPt++;
+		pin_ptr<Point> pPinnedPoints = &points[0];
+		Point* pPoints = pPinnedPoints;
+		double hullTimeStart = omp_get_wtime();
+		result = ouelletHull64(reinterpret_cast<point*>(pPoints), points->Length, closeThePath, resultCount);
+		elapsedTimeInSec = omp_get_wtime() - hullTimeStart;
 	}
 
-	point q1rootPt = { q1p2.x, q1p1.y };
-	point q2rootPt = { q2p1.x, q2p2.y };
-	point q3rootPt = { q3p2.x, q3p1.y };
-	point q4rootPt = { q4p1.x, q4p2.y };
+	array<Point>^ resultManaged = gcnew array<Point>((int)resultCount);
+	CopyToManaged(result, resultCount, resultManaged);
 
-	// *************************
-	// Q1 Init
-	// *************************
+	double marshalingTimeInSec = omp_get_wtime() - timeStart - elapsedTimeInSec;
 
-	q1hullCapacity = _quadrantHullPointArrayInitialCapacity;
-	q1pHullPoints = new point[q1hullCapacity];
+	// The copy path, without the hull
+	timeStart = omp_get_wtime();
 
-	q1pHullPoints[0] = q1p1;
-	if (compare_points(q1p1, q1p2))
+	int count = points->Length;
+	point* pArrayOfPoint = new point[count];
+	for (int n = count - 1; n >= 0; n--)
 	{
-		q1hullCount = 1;
+		pArrayOfPoint[n].x = points[n].X;
+		pArrayOfPoint[n].y = points[n].Y;
 	}
-	else
+
+	array<Point>^ resultCopied = gcnew array<Point>((int)resultCount);
+	for (int n = 0; n < resultCount; n++)
 	{
-		q1pHullPoints[1] = q1p2;
-		q1hullCount = 2;
+		resultCopied[n].X = result[n].x;
+		resultCopied[n].Y = result[n].y;
 	}
 
-	// *************************
-	// Q2 Init
-	// *************************
+	delete[] pArrayOfPoint;
 
-	q2hullCapacity = _quadrantHullPointArrayInitialCapacity;
-	q2pHullPoints = new point[q2hullCapacity];
+	savedTimeInSec = omp_get_wtime() - timeStart - marshalingTimeInSec;
 
-	q2pHullPoints[0] = q2p1;
-	if (compare_points(q2p1, q2p2))
-	{
-		q2hullCount = 1;
-	}
-	else
-	{
-		q2pHullPoints[1] = q2p2;
-		q2hullCount = 2;
-	}
+	delete[] result;
 
-	// *************************
-	// Q3 Init
-	// *************************
+	return resultManaged;
+}
 
-	q3hullCapacity = _quadrantHullPointArrayInitialCapacity;
-	q3pHullPoints = new point[q3hullCapacity];
+// **************************************************************************
+int OuelletConvexHullCpp::OuelletHullManagedPooled(array<Point>^ points, bool closeThePath, array<Point>^% results)
+{
+	int64_t resultCount;
+	point* result = OuelletHullPinned(points, closeThePath, resultCount);
 
-	q3pHullPoints[0] = q3p1;
-	if (compare_points(q3p1, q3p2))
-	{
-		q3hullCount = 1;
-	}
-	else
+	if (_resultPool == nullptr || _resultPool->Length < resultCount)
 	{
-		q3pHullPoints[1] = q3p2;
-		q3hullCount = 2;
+		int capacity = _resultPool == nullptr ? 1024 : _resultPool->Length;
+		while (capacity < resultCount)
+		{
+			capacity *= 2;
+		}
+		_resultPool = gcnew array<Point>(capacity);
 	}
+	CopyToManaged(result, resultCount, _resultPool);
 
-	// *************************
-	// Q4 Init
-	// *************************
+	delete[] result;
 
-	q4hullCapacity = _quadrantHullPointArrayInitialCapacity;
-	q4pHullPoints = new point[q4hullCapacity];
+	results = _resultPool;
+	return (int)resultCount;
+}
 
-	q4pHullPoints[0] = q4p1;
-	if (compare_points(q4p1, q4p2))
-	{
-		q4hullCount = 1;
-	}
-	else
+// **************************************************************************
+array<Point>^ OuelletConvexHullCpp::ParallelHullManagedWithElapsedTime(int engine, array<Point>^ points, bool closeThePath,
+	double% elapsedTimeInSec)
+{
+	int64_t resultCount = 0;
+	point* result = NULL;
+	elapsedTimeInSec = 0;
+	if (points->Length > 0)
 	{
-		q4pHullPoints[1] = q4p2;
-		q4hullCount = 2;
+		pin_ptr<Point> pPinnedPoints = &points[0];
+		Point* pPoints = pPinnedPoints;
+		double hullTimeStart = omp_get_wtime();
+		result = engine == ParallelHullQuick ?
+			parallelQuickHull(reinterpret_cast<point*>(pPoints), points->Length, 0, closeThePath, resultCount) :
+			parallelDivideAndConquerHull(reinterpret_cast<point*>(pPoints), points->Length, 0, closeThePath, resultCount);
+		elapsedTimeInSec = omp_get_wtime() - hullTimeStart;
 	}
-	
-	// *************************
-	// Start Calc	
-	// *************************
 
-	// Calc per quadrant
-	int index;
-	int indexLow;
-	int indexHi;
+	array<Point>^ resultManaged = gcnew array<Point>((int)resultCount);
+	CopyToManaged(result, resultCount, resultManaged);
 
-	// Currently hardcoded, could be calculated or pass as argument by user, dynamic, grow as needed
+	delete[] result;
 
-	pPt = _pPoints;
+	return resultManaged;
+}
 
-	for (int n = _countOfPoint - 1; n >= 0; n--) // -1 because 0 bound.
+// **************************************************************************
+array<Point>^ OuelletConvexHullCpp::MonotoneChainHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath,
+	double% elapsedTimeInSec)
+{
+	int64_t resultCount = 0;
+	point* result = NULL;
+	elapsedTimeInSec = 0;
+	if (points->Length > 0)
 	{
-		point& pt = *pPt;
-
-		// ****************************************************************
-		// Q1 Calc
-		// ****************************************************************
-
-		// Begin get insertion point
-		if (pt.x > q1rootPt.x && pt.y > q1rootPt.y) // Is point is in Q1
-		{
-			indexLow = 0;
-			indexHi = q1hullCount;
-
-			while (indexLow < indexHi - 1)
-			{
-				index = ((indexHi - indexLow) >> 1) + indexLow;
-
-				if (pt.x <= q1pHullPoints[index].x && pt.y <= q1pHullPoints[index].y)
-				{
-					goto currentPointNotPartOfq1Hull; // No calc needed
-				}
-
-				if (pt.x > q1pHullPoints[index].x)
-				{
-					indexHi = index;
-					continue;
-				}
-
-				if (pt.x < q1pHullPoints[index].x)
-				{
-					indexLow = index;
-					continue;
-				}
-
-				indexLow = index - 1;
-				indexHi = index + 1;
-				break;
-			}
-
-			// Here indexLow should contains the index where the point should be inserted 
-			// if calculation does not invalidate it.
-
-			if (!right_turn(q1pHullPoints[indexLow], q1pHullPoints[indexHi], pt))
-			{
-				goto currentPointNotPartOfq1Hull;
-			}
-
-			// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
-
-			// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// But indexLow and indexHi can change because it could invalidate many points before or after.
-
-			// Find lower bound (remove point invalidate by the new one that come before)
-			while (indexLow > 0)
-			{
-				if (right_turn(q1pHullPoints[indexLow - 1], pt, q1pHullPoints[indexLow]))
-				{
-					break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
-				}
-				indexLow--;
-			}
-
-			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q1hullCount - 1;
-			while (indexHi < maxIndexHi)
-			{
-				if (right_turn(pt, q1pHullPoints[indexHi + 1], q1pHullPoints[indexHi]))
-				{
-					break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
-				}
-				indexHi++;
-			}
-
-			if (indexLow + 1 == indexHi)
-			{
-				InsertPoint(q1pHullPoints, indexLow + 1, pt, q1hullCount, q1hullCapacity);
-
-				goto nextPoint;
-			}
-			else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
-			{
-				q1pHullPoints[indexLow + 1] = *pPt;
-				goto nextPoint;
-			}
-			else
-			{
-				q1pHullPoints[indexLow + 1] = *pPt;
-				RemoveRange(q1pHullPoints, indexLow + 2, indexHi -1, q1hullCount);
-				goto nextPoint;
-			}
-		}
-
-	currentPointNotPartOfq1Hull:
-
-		// ****************************************************************
-		// Q2 Calc
-		// ****************************************************************
-
-		// Begin get insertion point
-		if (pt.x < q2rootPt.x && pt.y > q2rootPt.y) // Is point is in q2
-		{
-			indexLow = 0;
-			indexHi = q2hullCount;
-
-			while (indexLow < indexHi - 1)
-			{
-				index = ((indexHi - indexLow) >> 1) + indexLow;
-
-				if (pt.x >= q2pHullPoints[index].x && pt.y <= q2pHullPoints[index].y)
-				{
-					goto currentPointNotPartOfq2Hull; // No calc needed
-				}
-
-				if (pt.x > q2pHullPoints[index].x)
-				{
-					indexHi = index;
-					continue;
-				}
-
-				if (pt.x < q2pHullPoints[index].x)				{
-					indexLow = index;
-					continue;
-				}
-
-				indexLow = index - 1;
-				indexHi = index + 1;
-				break;
-			}
-
-			// Here indexLow should contains the index where the point should be inserted 
-			// if calculation does not invalidate it.
-
-			if (!right_turn(q2pHullPoints[indexLow], q2pHullPoints[indexHi], pt))
-			{
-				goto currentPointNotPartOfq2Hull;
-			}
-
-			// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
-
-			// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// But indexLow and indexHi can change because it could invalidate many points before or after.
-
-			// Find lower bound (remove point invalidate by the new one that come before)
-			while (indexLow > 0)
-			{
-				if (right_turn(q2pHullPoints[indexLow - 1], pt, q2pHullPoints[indexLow]))
-				{
-					break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
-				}
-				indexLow--;
-			}
-
-			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q2hullCount - 1;
-			while (indexHi < maxIndexHi)
-			{
-				if (right_turn(pt, q2pHullPoints[indexHi + 1], q2pHullPoints[indexHi]))
-				{
-					break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
-				}
-				indexHi++;
-			}
-
-			if (indexLow + 1 == indexHi)
-			{
-				InsertPoint(q2pHullPoints, indexLow + 1, pt, q2hullCount, q2hullCapacity);
-
-				goto nextPoint;
-			}
-			else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
-			{
-				q2pHullPoints[indexLow + 1] = *pPt;
-				goto nextPoint;
-			}
-			else
-			{
-				q2pHullPoints[indexLow + 1] = *pPt;
-				RemoveRange(q2pHullPoints, indexLow + 2, indexHi - 1, q2hullCount);
-				goto nextPoint;
-			}
-		}
-
-	currentPointNotPartOfq2Hull:
-
-		// ****************************************************************
-		// Q3 Calc
-		// ****************************************************************
+		pin_ptr<Point> pPinnedPoints = &points[0];
+		Point* pPoints = pPinnedPoints;
+		double hullTimeStart = omp_get_wtime();
+		result = monotoneChainHull(reinterpret_cast<point*>(pPoints), points->Length, closeThePath, resultCount);
+		elapsedTimeInSec = omp_get_wtime() - hullTimeStart;
+	}
 
-		// Begin get insertion point
-		if (pt.x < q3rootPt.x && pt.y < q3rootPt.y) // Is point is in q3
-		{
-			indexLow = 0;
-			indexHi = q3hullCount;
-
-			while (indexLow < indexHi - 1)
-			{
-				index = ((indexHi - indexLow) >> 1) + indexLow;
-
-				if (pt.x >= q3pHullPoints[index].x && pt.y >= q3pHullPoints[index].y)
-				{
-					goto currentPointNotPartOfq3Hull; // No calc needed
-				}
-
-				if (pt.x < q3pHullPoints[index].x)
-				{
-					indexHi = index;
-					continue;
-				}
-
-				if (pt.x > q3pHullPoints[index].x)
-				{
-					indexLow = index;
-					continue;
-				}
-
-				indexLow = index - 1;
-				indexHi = index + 1;
-				break;
-			}
-
-			// Here indexLow should contains the index where the point should be inserted 
-			// if calculation does not invalidate it.
-
-			if (!right_turn(q3pHullPoints[indexLow], q3pHullPoints[indexHi], pt))
-			{
-				goto currentPointNotPartOfq3Hull;
-			}
-
-			// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
-
-			// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// But indexLow and indexHi can change because it could invalidate many points before or after.
-
-			// Find lower bound (remove point invalidate by the new one that come before)
-			while (indexLow > 0)
-			{
-				if (right_turn(q3pHullPoints[indexLow - 1], pt, q3pHullPoints[indexLow]))
-				{
-					break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
-				}
-				indexLow--;
-			}
-
-			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q3hullCount - 1;
-			while (indexHi < maxIndexHi)
-			{
-				if (right_turn(pt, q3pHullPoints[indexHi + 1], q3pHullPoints[indexHi]))
-				{
-					break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
-				}
-				indexHi++;
-			}
-
-			if (indexLow + 1 == indexHi)
-			{
-				InsertPoint(q3pHullPoints, indexLow + 1, pt, q3hullCount, q3hullCapacity);
-
-				goto nextPoint;
-			}
-			else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
-			{
-				q3pHullPoints[indexLow + 1] = *pPt;
-				goto nextPoint;
-			}
-			else
-			{
-				q3pHullPoints[indexLow + 1] = *pPt;
-				RemoveRange(q3pHullPoints, indexLow + 2, indexHi - 1, q3hullCount);
-				goto nextPoint;
-			}
-		}
+	array<Point>^ resultManaged = gcnew array<Point>((int)resultCount);
+	CopyToManaged(result, resultCount, resultManaged);
 
-	currentPointNotPartOfq3Hull:
+	delete[] result;
 
-		// ****************************************************************
-		// Q4 Calc
-		// ****************************************************************
+	return resultManaged;
+}
 
-		// Begin get insertion point
-		if (pt.x > q4rootPt.x && pt.y < q4rootPt.y) // Is point is in q4
-		{
-			indexLow = 0;
-			indexHi = q4hullCount;
-
-			while (indexLow < indexHi - 1)
-			{
-				index = ((indexHi - indexLow) >> 1) + indexLow;
-
-				if (pt.x <= q4pHullPoints[index].x && pt.y >= q4pHullPoints[index].y)
-				{
-					goto currentPointNotPartOfq4Hull; // No calc needed
-				}
-
-				if (pt.x < q4pHullPoints[index].x)
-				{
-					indexHi = index;
-					continue;
-				}
-
-				if (pt.x > q4pHullPoints[index].x)
-				{
-					indexLow = index;
-					continue;
-				}
-
-				indexLow = index - 1;
-				indexHi = index + 1;
-				break;
-			}
-
-			// Here indexLow should contains the index where the point should be inserted 
-			// if calculation does not invalidate it.
-
-			if (!right_turn(q4pHullPoints[indexLow], q4pHullPoints[indexHi], pt))
-			{
-				goto currentPointNotPartOfq4Hull;
-			}
-
-			// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
-
-			// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
-			// But indexLow and indexHi can change because it could invalidate many points before or after.
-
-			// Find lower bound (remove point invalidate by the new one that come before)
-			while (indexLow > 0)
-			{
-				if (right_turn(q4pHullPoints[indexLow - 1], pt, q4pHullPoints[indexLow]))
-				{
-					break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
-				}
-				indexLow--;
-			}
-
-			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q4hullCount - 1;
-			while (indexHi < maxIndexHi)
-			{
-				if (right_turn(pt, q4pHullPoints[indexHi + 1], q4pHullPoints[indexHi]))
-				{
-					break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
-				}
-				indexHi++;
-			}
-
-			if (indexLow + 1 == indexHi)
-			{
-				InsertPoint(q4pHullPoints, indexLow + 1, pt, q4hullCount, q4hullCapacity);
-
-				goto nextPoint;
-			}
-			else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
-			{
-				q4pHullPoints[indexLow + 1] = *pPt;
-				goto nextPoint;
-			}
-			else
-			{
-				q4pHullPoints[indexLow + 1] = *pPt;
-				RemoveRange(q4pHullPoints, indexLow + 2, indexHi - 1, q4hullCount);
-				goto nextPoint;
-			}
-		}
+// **************************************************************************
+array<Point>^ OuelletConvexHullCpp::AutoHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath,
+	double% elapsedTimeInSec, int% engine)
+{
+	int64_t resultCount = 0;
+	point* result = NULL;
+	elapsedTimeInSec = 0;
+	engine = AutoHullOuellet;
+	if (points->Length > 0)
+	{
+		pin_ptr<Point> pPinnedPoints = &points[0];
+		Point* pPoints = pPinnedPoints;
+		AutoHullDecision decision;
+		double hullTimeStart = omp_get_wtime();
+		result = autoHull(reinterpret_cast<point*>(pPoints), points->Length, closeThePath, resultCount, decision);
+		elapsedTimeInSec = omp_get_wtime() - hullTimeStart;
+		engine = decision.engine;
+	}
 
-	currentPointNotPartOfq4Hull:
-		
-		// *************************************** All quadrant are done
+	array<Point>^ resultManaged = gcnew array<Point>((int)resultCount);
+	CopyToManaged(result, resultCount, resultManaged);
 
-	nextPoint:
-		pPt++;
-	}
+	delete[] result;
 
+	return resultManaged;
 }
 
 // **************************************************************************
-void OuelletHull::InsertPoint(point*& pPoint, int index, point& pt, int& count, int& capacity)
+array<double>^ OuelletConvexHullCpp::Benchmark(int engine, array<Point>^ points, int warmupCount, int iterationCount, bool pinThreads)
 {
-	// make some room to insert the point. make sure to not reach capacity and/or adjust it
-	if (count >= capacity)
+	if (points->Length == 0)
+	{
+		return nullptr;
+	}
+
+	HullBenchmarkOptions options;
+	options.warmupCount = warmupCount;
+	options.iterationCount = iterationCount;
+	options.pinThreads = pinThreads;
+
+	HullBenchmarkResult result;
+	pin_ptr<Point> pPinnedPoints = &points[0];
+	Point* pPoints = pPinnedPoints;
+	if (!hullBenchmark(engine, reinterpret_cast<point*>(pPoints), points->Length, options, result, NULL))
 	{
-		// Should make some room
-		//int newCapacity = capacity + _quadrantHullPointArrayGrowSize; // Very bad in the worse case. Fallback to regular way of growing list capacity
-		int newCapacity = capacity * 2;
-		point* newPointArray = new point[newCapacity];
-		memmove(newPointArray, pPoint, capacity * sizeof(point));
-		delete pPoint;
-		pPoint = newPointArray;
-		capacity = newCapacity;
+		return nullptr;
 	}
-	
-	memmove(&(pPoint[index + 1]), &(pPoint[index]), (count - index) * sizeof(point));
 
-	// Insert Point at index 
-	pPoint[index] = pt;
-	count++;
+	array<double>^ seconds = gcnew array<double>(5);
+	seconds[0] = result.minSeconds;
+	seconds[1] = result.medianSeconds;
+	seconds[2] = result.p95Seconds;
+	seconds[3] = result.meanSeconds;
+	seconds[4] = result.stddevSeconds;
+	return seconds;
 }
 
 // **************************************************************************
-/// Remove every item in from index start to indexEnd inclusive 
-void OuelletHull::RemoveRange(point* pPoint, int indexStart, int indexEnd, int &count)
+int OuelletConvexHullCpp::RegressionGate(System::String^ baselinePath, int64_t pointCount, int iterationCount, double threshold,
+	double confidence, bool updateBaseline, System::String^% report)
 {
-	memmove(&(pPoint[indexStart]), &(pPoint[indexEnd + 1]), (count - indexEnd) * sizeof(point));
-	count -= (indexEnd - indexStart + 1);
+	System::IntPtr pPath = System::Runtime::InteropServices::Marshal::StringToHGlobalAnsi(baselinePath);
+
+	HullRegressionOptions options;
+	options.baselinePath = static_cast<const char*>(pPath.ToPointer());
+	options.machine = NULL;
+	options.engineMask = 0;
+	options.distributionMask = 0;
+	options.pointCount = pointCount;
+	options.warmupCount = 2;
+	options.iterationCount = iterationCount;
+	options.threshold = threshold;
+	options.confidence = confidence;
+	options.updateBaseline = updateBaseline;
+
+	char* pReport;
+	int status = hullRegressionGate(options, &pReport);
+	System::Runtime::InteropServices::Marshal::FreeHGlobal(pPath);
+
+	report = gcnew System::String(pReport);
+	delete[] pReport;
+	return status;
 }
 
 // **************************************************************************
-OuelletHull::OuelletHull(point* points, int countOfPoint, bool shouldCloseTheGraph)
+extern "C" point* ouelletHull(point* pArrayOfPoint, int count, bool closeThePath, int& resultCount)
 {
-	_pPoints = points;
-	_countOfPoint = countOfPoint;
-	_shouldCloseTheGraph = shouldCloseTheGraph;
-
-	CalcConvexHull();
+	OuelletHull convexHull(pArrayOfPoint, count, closeThePath);
+	return convexHull.GetResultAsArray(resultCount);
 }
 
 // **************************************************************************
-OuelletHull::~OuelletHull()
+extern "C" point* ouelletHull64(point* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount)
 {
-	delete q1pHullPoints;
-	delete q2pHullPoints;
-	delete q3pHullPoints;
-	delete q4pHullPoints;
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, closeThePath);
+	return convexHull.GetResultAsArray(resultCount);
 }
 
 // **************************************************************************
-point* OuelletHull::GetResultAsArray(int& hullPointCount)
+extern "C" int64_t ouelletHullInPlace(point* pArrayOfPoint, int64_t count)
 {
-	hullPointCount = 0;
-	if (this->_countOfPoint == 0)
-	{
-		return NULL;
-	}
-
-	unsigned int indexQ1Start;
-	unsigned int indexQ2Start;
-	int indexQ3Start;
-	int indexQ4Start;
-	int indexQ1End;
-	int indexQ2End;
-	int indexQ3End;
-	int indexQ4End;
-
-	indexQ1Start = 0;
-	indexQ1End = q1hullCount - 1;
-	point pointLast = q1pHullPoints[indexQ1End];
-
-	if (q2hullCount == 1)
-	{
-		if (compare_points(*q2pHullPoints, pointLast)) // 
-		{
-			indexQ2Start = 1;
-			indexQ2End = 0;
-		}
-		else
-		{
-			indexQ2Start = 0;
-			indexQ2End = 0;
-			pointLast = *q2pHullPoints;
-		}
-	}
-	else
-	{
-		if (compare_points(*q2pHullPoints, pointLast))
-		{
-			indexQ2Start = 1;
-		}
-		else
-		{
-			indexQ2Start = 0;
-		}
-		indexQ2End = q2hullCount - 1;
-		pointLast = q2pHullPoints[indexQ2End];
-	}
-
-	if (q3hullCount == 1)
-	{
-		if (compare_points(*q3pHullPoints, pointLast))
-		{
-			indexQ3Start = 1;
-			indexQ3End = 0;
-		}
-		else
-		{
-			indexQ3Start = 0;
-			indexQ3End = 0;
-			pointLast = *q3pHullPoints;
-		}
-	}
-	else
-	{
-		if (compare_points(*q3pHullPoints, pointLast))
-		{
-			indexQ3Start = 1;
-		}
-		else
-		{
-			indexQ3Start = 0;
-		}
-		indexQ3End = q3hullCount - 1;
-		pointLast = q3pHullPoints[indexQ3End];
-	}
-
-	if (q4hullCount == 1)
-	{
-		if (compare_points(*q4pHullPoints, pointLast))
-		{
-			indexQ4Start = 1;
-			indexQ4End = 0;
-		}
-		else
-		{
-			indexQ4Start = 0;
-			indexQ4End = 0;
-			pointLast = *q4pHullPoints;
-		}
-	}
-	else
-	{
-		if (compare_points(*q4pHullPoints, pointLast))
-		{
-			indexQ4Start = 1;
-		}
-		else
-		{
-			indexQ4Start = 0;
-		}
-
-		indexQ4End = q4hullCount - 1;
-		pointLast = q4pHullPoints[indexQ4End];
-	}
-
-	if (compare_points(q1pHullPoints[indexQ1Start], pointLast))
-	{
-		indexQ1Start++;
-	}
-
-	int countOfFinalHullPoint = (indexQ1End - indexQ1Start) +
-		(indexQ2End - indexQ2Start) +
-		(indexQ3End - indexQ3Start) +
-		(indexQ4End - indexQ4Start) + 4;
-
-	if (countOfFinalHullPoint <= 1) // Case where there is only one point or many of only the same point. Auto closed if required.
-	{
-		return new point[1]{ pointLast };
-	}
-
-	if (countOfFinalHullPoint > 1 && _shouldCloseTheGraph)
-	{
-		countOfFinalHullPoint++;
-	}
-
-	point* results = new point[countOfFinalHullPoint];
-
-	int resIndex = 0;
-
-	for (int n = indexQ1Start; n <= indexQ1End; n++)
-	{
-		results[resIndex] = q1pHullPoints[n];
-		resIndex++;
-	}
-
-	for (int n = indexQ2Start; n <= indexQ2End; n++)
-	{
-		results[resIndex] = q2pHullPoints[n];
-		resIndex++;
-	}
-
-	for (int n = indexQ3Start; n <= indexQ3End; n++)
-	{
-		results[resIndex] = q3pHullPoints[n];
-		resIndex++;
-	}
-
-	for (int n = indexQ4Start; n <= indexQ4End; n++)
+	if (count <= 0)
 	{
-		results[resIndex] = q4pHullPoints[n];
-		resIndex++;
+		return 0;
 	}
 
-	if (countOfFinalHullPoint > 1 && _shouldCloseTheGraph)
-	{
-		results[resIndex] = results[0];
-	}
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, false);
+	return convexHull.MoveResultToFront();
+}
 
-	hullPointCount = countOfFinalHullPoint;
+// **************************************************************************
+extern "C" point* ouelletHullSinglePass(point* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount)
+{
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, closeThePath, true);
+	return convexHull.GetResultAsArray(resultCount);
+}
 
-	return results;
+// **************************************************************************
+extern "C" point* ouelletHullWarmStart(point* pArrayOfPoint, int64_t count, const int64_t* pSeedIndexes, int64_t seedCount, bool closeThePath, int64_t& resultCount)
+{
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, pSeedIndexes, (count_t)seedCount, closeThePath);
+	return convexHull.GetResultAsArray(resultCount);
 }
 
 // **************************************************************************
+extern "C" pointWithId* ouelletHullWithIds(pointWithId* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount)
+{
+	OuelletHullOf<pointWithId> convexHull(pArrayOfPoint, (count_t)count, closeThePath);
+	return convexHull.GetResultAsArray(resultCount);
+}
 
+// **************************************************************************
+int64_t ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int64_t count)
+{
+	int64_t resultCount;
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, true);
+	convexHull.GetResultAsArray(resultCount);
+	return resultCount;
+}
 
+// **************************************************************************
@@ -2,62 +2,169 @@
 
 #include <math.h>
 #include "Point.h"
+#include "PerfCounters.h"
 
 using namespace System::Windows;
 
+// Points are not copied to native arrays: System::Windows::Point has the layout of point, managed arrays are
+// pinned and given to the engine as they are.
 public ref class OuelletConvexHullCpp
 {
+private:
+	array<Point>^ _resultPool; // Of OuelletHullManagedPooled
+
 public:
 	array<Point>^ OuelletHullManaged(array<Point>^ points, bool closeThePath);
 	array<Point>^ OuelletHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath, double% elapsedTimeInSec);
+	// savedTimeInSec: marshaling time of the copy path (points copied one by one to a native array, the result one
+	// by one to the managed one) less the one of the pinned path. The copy path is run after the hull to be timed.
+	array<Point>^ OuelletHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath, double% elapsedTimeInSec,
+		double% savedTimeInSec);
+
+	// Result in a buffer of this instance, reused (grown when too small) by the next calls: nothing is allocated
+	// once it is big enough. Returns the count of points of the result, the buffer can be longer.
+	int OuelletHullManagedPooled(array<Point>^ points, bool closeThePath, array<Point>^% results);
+
+	// parallelQuickHull or parallelDivideAndConquerHull (ParallelHullEngine), one thread per core
+	array<Point>^ ParallelHullManagedWithElapsedTime(int engine, array<Point>^ points, bool closeThePath, double% elapsedTimeInSec);
+	// monotoneChainHull: radix sort, then monotone chain
+	array<Point>^ MonotoneChainHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath, double% elapsedTimeInSec);
+	// autoHull, engine: the AutoHullEngine it chose
+	array<Point>^ AutoHullManagedWithElapsedTime(array<Point>^ points, bool closeThePath, double% elapsedTimeInSec, int% engine);
+
+	// hullBenchmark of an engine (HullBenchmarkEngine) on the points: min, median, p95, mean and standard
+	// deviation in seconds. nullptr for an unknown engine or no points.
+	array<double>^ Benchmark(int engine, array<Point>^ points, int warmupCount, int iterationCount, bool pinThreads);
+
+	// hullRegressionGate of all engines on all distributions, 2 warmup runs. Returns a HullRegressionStatus.
+	int RegressionGate(System::String^ baselinePath, int64_t pointCount, int iterationCount, double threshold,
+		double confidence, bool updateBaseline, System::String^% report);
+};
+
+// Phases of OuelletHull, for PerfPhaseCounters
+enum OuelletHullPhase
+{
+	OuelletHullPhaseLimits = 0, // Scan for the quadrant limits, quadrant hulls init
+	OuelletHullPhaseSearch = 1, // Points against the quadrant hulls: binary search and turns
+	OuelletHullPhaseMove = 2, // memmove of the quadrant hull arrays (InsertPoint, RemoveRange)
+	OuelletHullPhaseResult = 3, // GetResultAsArray, entered by the caller
+	OuelletHullPhaseCount = 4,
+};
+
+// Point with a payload (index in the source, timestamp...) that travels with it: coordinates first, as point.
+struct pointWithId
+{
+	number x;
+	number y;
+	int64_t id;
 };
 
-class OuelletHull
+// Engine on any point type TPoint: a plain struct (copied with memmove) whose coordinates are the number members
+// x and y, as point, followed by any payload. Points are kept by value in the quadrant arrays, the result has
+// their payload with no lookup. Coordinates first keep them together with the ones of the next point; the arrays
+// only hold hull candidates, so a bigger point slows down mostly the read of the input.
+template <typename TPoint>
+class OuelletHullOf
 {
 private:
 	static const int _quadrantHullPointArrayInitialCapacity = 1000;
 	static const int _quadrantHullPointArrayGrowSize = 1000;
 
-	point* _pPoints;
-	int _countOfPoint;
+	TPoint* _pPoints;
+	count_t _countOfPoint;
 	bool _shouldCloseTheGraph;
+	const int64_t* _pSeedIndexes = NULL;
+	count_t _seedCount = 0;
+	PerfPhaseCounters* _pPhaseCounters = NULL; // Instrumentation only
+	bool _isSinglePass = false;
 
-	point* q1pHullPoints;
-	point* q1pHullLast;
-	int q1hullCapacity;
-	int q1hullCount = 0;
+	// Quadrant limits: q1p1 rightmost (then highest), q1p2 highest (then rightmost), and so on counter clockwise
+	TPoint q1p1;
+	TPoint q1p2;
+	TPoint q2p1;
+	TPoint q2p2;
+	TPoint q3p1;
+	TPoint q3p2;
+	TPoint q4p1;
+	TPoint q4p2;
 
-	point* q2pHullPoints;
-	point* q2pHullLast;
-	int q2hullCapacity;
-	int q2hullCount = 0;
+	TPoint* q1pHullPoints = NULL;
+	TPoint* q1pHullLast;
+	count_t q1hullCapacity;
+	count_t q1hullCount = 0;
 
-	point* q3pHullPoints;
-	point* q3pHullLast;
-	int q3hullCapacity;
-	int q3hullCount = 0;
+	TPoint* q2pHullPoints = NULL;
+	TPoint* q2pHullLast;
+	count_t q2hullCapacity;
+	count_t q2hullCount = 0;
 
-	point* q4pHullPoints;
-	point* q4pHullLast;
-	int q4hullCapacity;
-	int q4hullCount = 0;
+	TPoint* q3pHullPoints = NULL;
+	TPoint* q3pHullLast;
+	count_t q3hullCapacity;
+	count_t q3hullCount = 0;
+
+	TPoint* q4pHullPoints = NULL;
+	TPoint* q4pHullLast;
+	count_t q4hullCapacity;
+	count_t q4hullCount = 0;
+
+	point q1rootPt;
+	point q2rootPt;
+	point q3rootPt;
+	point q4rootPt;
 
 	void CalcConvexHull();
+	void CalcConvexHullSinglePass();
+	void ScanLimits(const TPoint* pPt, count_t count);
+	void InitQuadrantHulls();
+	void RebuildQuadrantHulls();
+	inline void ProcessPoint(TPoint& pt);
+	bool GetInnerBox(point& innerMin, point& innerMax);
+	count_t GetResultRanges(count_t* pIndexStarts, count_t* pIndexEnds, TPoint& pointLast);
 
-	inline static void InsertPoint(point*& pPoint, int index, point& pt, int& count, int& capacity);
-	inline static void RemoveRange(point* pPoint, int indexStart, int indexEnd, int &count);
+	inline void InsertPoint(TPoint*& pPoint, count_t index, TPoint& pt, count_t& count, count_t& capacity);
+	inline void RemoveRange(TPoint* pPoint, count_t indexStart, count_t indexEnd, count_t &count);
 
 public:
-	OuelletHull(point* points, int countOfPoint, bool shouldCloseTheGraph = true);
-	~OuelletHull();
-	point* GetResultAsArray(int& count);
+	OuelletHullOf(TPoint* points, count_t countOfPoint, bool shouldCloseTheGraph = true);
+	// Warm start: pSeedIndexes are indexes in points of likely hull vertices (ex: the hull of the previous frame
+	// of a slowly moving cloud). They are processed first to reject most of the other points early.
+	OuelletHullOf(TPoint* points, count_t countOfPoint, const int64_t* pSeedIndexes, count_t seedCount, bool shouldCloseTheGraph = true);
+	// Hardware counters by OuelletHullPhase (hullBenchmarkCounters). Leaves pPhaseCounters out of any phase.
+	OuelletHullOf(TPoint* points, count_t countOfPoint, bool shouldCloseTheGraph, PerfPhaseCounters* pPhaseCounters);
+	// Single pass: points are read once, by blocks that stay in cache. The quadrant limits of the points so far
+	// give provisional roots, when a block moves a limit the quadrant hulls are rebuilt from their own points
+	// with the new roots, then the points of the block are processed. Same result as the two passes, half the
+	// memory reads: faster on inputs bigger than the cache. When rebuilds have cost as much as the blocks (sorted
+	// or sweeping input), the limits of the points left are scanned at once: O(n) more at most.
+	OuelletHullOf(TPoint* points, count_t countOfPoint, bool shouldCloseTheGraph, bool isSinglePass,
+		PerfPhaseCounters* pPhaseCounters = NULL);
+	~OuelletHullOf();
+	TPoint* GetResultAsArray(int& count);
+	TPoint* GetResultAsArray(int64_t& count);
+	// In place result: the hull vertices are moved to the front of the points, in the order of GetResultAsArray
+	// (not closed), the other points after them in any order. Returns the count of vertices.
+	count_t MoveResultToFront();
 };
 
-int ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int count);
+typedef OuelletHullOf<point> OuelletHull;
+
+extern template class OuelletHullOf<point>;
+extern template class OuelletHullOf<pointWithId>;
+
+int64_t ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int64_t count);
 
 extern "C" 
 {
 	point* ouelletHull(point* pArrayOfPoint, int count, bool closeThePath, int& resultCount);
+	point* ouelletHull64(point* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount);
+	// In place: pArrayOfPoint is permuted, its first (returned count) points are the hull, counter clockwise
+	// in the order of ouelletHull64 (not closed). Only O(h) memory is allocated.
+	int64_t ouelletHullInPlace(point* pArrayOfPoint, int64_t count);
+	point* ouelletHullSinglePass(point* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount);
+	// The ids come with the hull points, in the order of ouelletHull64
+	pointWithId* ouelletHullWithIds(pointWithId* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount);
+	point* ouelletHullWarmStart(point* pArrayOfPoint, int64_t count, const int64_t* pSeedIndexes, int64_t seedCount, bool closeThePath, int64_t& resultCount);
 //	array<ManagedPoint>^ ouelletHullManaged(point* pArrayOfPoint, int count);
 }
 
@@ -0,0 +1,1235 @@
+#pragma once
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "OuelletHull.h"
+
+// Definitions of OuelletHullOf. OuelletHull.cpp instantiates it for point and pointWithId, include this file to
+// instantiate it for another point type.
+
+// Points of a block of the single pass: read once for the limits, again from the cache to be processed
+#define OUELLET_HULL_BLOCK_SIZE 4096
+
+// **************************************************************************
+template <typename TPoint>
+void OuelletHullOf<TPoint>::CalcConvexHull()
+{
+	if (_isSinglePass)
+	{
+		CalcConvexHullSinglePass();
+		return;
+	}
+
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(OuelletHullPhaseLimits);
+	}
+
+	TPoint* pPt;
+
+	// Find the quadrant limits (maximum x and y)
+	q1p1 = q1p2 = q2p1 = q2p2 = q3p1 = q3p2 = q4p1 = q4p2 = *_pPoints;
+	ScanLimits(_pPoints + 1, _countOfPoint - 1);
+
+	InitQuadrantHulls();
+	
+	// *************************
+	// Start Calc	
+	// *************************
+
+	// Calc per quadrant
+	// Currently hardcoded, could be calculated or pass as argument by user, dynamic, grow as needed
+
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(OuelletHullPhaseSearch);
+	}
+
+	// Warm start: seeds (usually the hull vertices of the previous frame) go first. Seeds are points of the set,
+	// the result is the same. The quadrant hulls are then almost complete: a box inside them rejects most of the
+	// other points with 4 comparisons and the rest rarely change the quadrant hulls.
+	if (_seedCount > 0)
+	{
+		for (count_t n = 0; n < _seedCount; n++)
+		{
+			int64_t seedIndex = _pSeedIndexes[n];
+			if (seedIndex >= 0 && seedIndex < _countOfPoint)
+			{
+				ProcessPoint(_pPoints[seedIndex]);
+			}
+		}
+
+		point innerMin;
+		point innerMax;
+		if (GetInnerBox(innerMin, innerMax))
+		{
+			pPt = _pPoints;
+
+			for (count_t n = _countOfPoint - 1; n >= 0; n--) // -1 because 0 bound.
+			{
+				if (pPt->x <= innerMin.x || pPt->x >= innerMax.x || pPt->y <= innerMin.y || pPt->y >= innerMax.y)
+				{
+					ProcessPoint(*pPt);
+				}
+				pPt++;
+			}
+
+			if (_pPhaseCounters != NULL)
+			{
+				_pPhaseCounters->Enter(-1);
+			}
+			return;
+		}
+	}
+
+	pPt = _pPoints;
+
+	for (count_t n = _countOfPoint - 1; n >= 0; n--) // -1 because 0 bound.
+	{
+		ProcessPoint(*pPt);
+		pPt++;
+	}
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(-1);
+	}
+}
+
+// **************************************************************************
+// Updates the quadrant limits with the points, the first ones win ties
+template <typename TPoint>
+void OuelletHullOf<TPoint>::ScanLimits(const TPoint* pPt, count_t count)
+{
+	for (count_t n = count; n > 0; n--)
+	{
+		const TPoint& pt = *pPt;
+
+		// Right
+		if (pt.x >= q1p1.x)
+		{
+			if (pt.x == q1p1.x)
+			{
+				if (pt.y > q1p1.y)
+				{
+					q1p1 = pt;
+				}
+				else
+				{
+					if (pt.y < q4p2.y)
+					{
+						q4p2 = pt;
+					}
+				}
+			}
+			else
+			{
+				q1p1 = pt;
+				q4p2 = pt;
+			}
+		}
+
+		// Left
+		if (pt.x <= q2p2.x)
+		{
+			if (pt.x == q2p2.x)
+			{
+				if (pt.y > q2p2.y)
+				{
+					q2p2 = pt;
+				}
+				else
+				{
+					if (pt.y < q3p1.y)
+					{
+						q3p1 = pt;
+					}
+				}
+			}
+			else
+			{
+				q2p2 = pt;
+				q3p1 = pt;
+			}
+		}
+
+		// Top
+		if (pt.y >= q1p2.y)
+		{
+			if (pt.y == q1p2.y)
+			{
+				if (pt.x < q2p1.x)
+				{
+					q2p1 = pt;
+				}
+				else
+				{
+					if (pt.x > q1p2.x)
+					{
+						q1p2 = pt;
+					}
+				}
+			}
+			else
+			{
+				q1p2 = pt;
+				q2p1 = pt;
+			}
+		}
+
+		// Bottom
+		if (pt.y <= q3p2.y)
+		{
+			if (pt.y == q3p2.y)
+			{
+				if (pt.x < q3p2.x)
+				{
+					q3p2 = pt;
+				}
+				else
+				{
+					if (pt.x > q4p1.x)
+					{
+						q4p1 = pt;
+					}
+				}
+			}
+			else
+			{
+				q3p2 = pt;
+				q4p1 = pt;
+			}
+		}
+
+		pPt++;
+	}
+}
+
+// **************************************************************************
+// Roots and quadrant hulls (their 2 limits) from the quadrant limits. Arrays are kept when there are some.
+template <typename TPoint>
+void OuelletHullOf<TPoint>::InitQuadrantHulls()
+{
+	q1rootPt = { q1p2.x, q1p1.y };
+	q2rootPt = { q2p1.x, q2p2.y };
+	q3rootPt = { q3p2.x, q3p1.y };
+	q4rootPt = { q4p1.x, q4p2.y };
+
+	// *************************
+	// Q1 Init
+	// *************************
+
+	if (q1pHullPoints == NULL)
+	{
+		q1hullCapacity = _quadrantHullPointArrayInitialCapacity;
+		q1pHullPoints = new TPoint[q1hullCapacity];
+	}
+
+	q1pHullPoints[0] = q1p1;
+	if (compare_points(q1p1, q1p2))
+	{
+		q1hullCount = 1;
+	}
+	else
+	{
+		q1pHullPoints[1] = q1p2;
+		q1hullCount = 2;
+	}
+
+	// *************************
+	// Q2 Init
+	// *************************
+
+	if (q2pHullPoints == NULL)
+	{
+		q2hullCapacity = _quadrantHullPointArrayInitialCapacity;
+		q2pHullPoints = new TPoint[q2hullCapacity];
+	}
+
+	q2pHullPoints[0] = q2p1;
+	if (compare_points(q2p1, q2p2))
+	{
+		q2hullCount = 1;
+	}
+	else
+	{
+		q2pHullPoints[1] = q2p2;
+		q2hullCount = 2;
+	}
+
+	// *************************
+	// Q3 Init
+	// *************************
+
+	if (q3pHullPoints == NULL)
+	{
+		q3hullCapacity = _quadrantHullPointArrayInitialCapacity;
+		q3pHullPoints = new TPoint[q3hullCapacity];
+	}
+
+	q3pHullPoints[0] = q3p1;
+	if (compare_points(q3p1, q3p2))
+	{
+		q3hullCount = 1;
+	}
+	else
+	{
+		q3pHullPoints[1] = q3p2;
+		q3hullCount = 2;
+	}
+
+	// *************************
+	// Q4 Init
+	// *************************
+
+	if (q4pHullPoints == NULL)
+	{
+		q4hullCapacity = _quadrantHullPointArrayInitialCapacity;
+		q4pHullPoints = new TPoint[q4hullCapacity];
+	}
+
+	q4pHullPoints[0] = q4p1;
+	if (compare_points(q4p1, q4p2))
+	{
+		q4hullCount = 1;
+	}
+	else
+	{
+		q4pHullPoints[1] = q4p2;
+		q4hullCount = 2;
+	}
+}
+
+// **************************************************************************
+// With the new limits, the quadrant hulls of the points so far are the ones of their current points (the hull
+// vertices so far) and the new limits. Their points are processed in hull order: each one is appended.
+template <typename TPoint>
+void OuelletHullOf<TPoint>::RebuildQuadrantHulls()
+{
+	count_t candidateCount = q1hullCount + q2hullCount + q3hullCount + q4hullCount;
+	TPoint* pCandidates = new TPoint[candidateCount];
+	TPoint* pCandidate = pCandidates;
+	memcpy(pCandidate, q1pHullPoints, q1hullCount * sizeof(TPoint));
+	pCandidate += q1hullCount;
+	memcpy(pCandidate, q2pHullPoints, q2hullCount * sizeof(TPoint));
+	pCandidate += q2hullCount;
+	memcpy(pCandidate, q3pHullPoints, q3hullCount * sizeof(TPoint));
+	pCandidate += q3hullCount;
+	memcpy(pCandidate, q4pHullPoints, q4hullCount * sizeof(TPoint));
+
+	InitQuadrantHulls();
+
+	for (count_t n = 0; n < candidateCount; n++)
+	{
+		ProcessPoint(pCandidates[n]);
+	}
+
+	delete[] pCandidates;
+}
+
+// **************************************************************************
+template <typename TPoint>
+void OuelletHullOf<TPoint>::CalcConvexHullSinglePass()
+{
+	// The same sequence of compares as the two passes: same limits at the end, whatever the blocks
+	q1p1 = q1p2 = q2p1 = q2p2 = q3p1 = q3p2 = q4p1 = q4p2 = *_pPoints;
+
+	// A rebuild processes the O(h) quadrant hull points again: on sorted or sweeping input the limits move at
+	// almost every block. Once rebuilds have processed as many points as the blocks, the limits of the points
+	// left are scanned at once (as the two passes do), for a last rebuild: O(n) more at most.
+	count_t rebuildPointCount = 0;
+	bool areLimitsFinal = false;
+
+	for (count_t blockStart = 0; blockStart < _countOfPoint; blockStart += OUELLET_HULL_BLOCK_SIZE)
+	{
+		count_t blockCount = _countOfPoint - blockStart < OUELLET_HULL_BLOCK_SIZE ? _countOfPoint - blockStart : OUELLET_HULL_BLOCK_SIZE;
+		TPoint* pBlock = _pPoints + blockStart;
+
+		if (!areLimitsFinal)
+		{
+			if (_pPhaseCounters != NULL)
+			{
+				_pPhaseCounters->Enter(OuelletHullPhaseLimits);
+			}
+
+			TPoint limits[8] = { q1p1, q1p2, q2p1, q2p2, q3p1, q3p2, q4p1, q4p2 };
+			ScanLimits(pBlock, blockCount);
+
+			if (blockStart == 0)
+			{
+				InitQuadrantHulls();
+			}
+			else if (!compare_points(limits[0], q1p1) || !compare_points(limits[1], q1p2) || !compare_points(limits[2], q2p1) ||
+				!compare_points(limits[3], q2p2) || !compare_points(limits[4], q3p1) || !compare_points(limits[5], q3p2) ||
+				!compare_points(limits[6], q4p1) || !compare_points(limits[7], q4p2))
+			{
+				rebuildPointCount += q1hullCount + q2hullCount + q3hullCount + q4hullCount;
+				if (rebuildPointCount > blockStart)
+				{
+					ScanLimits(pBlock + blockCount, _countOfPoint - blockStart - blockCount);
+					areLimitsFinal = true;
+				}
+				RebuildQuadrantHulls();
+			}
+		}
+
+		if (_pPhaseCounters != NULL)
+		{
+			_pPhaseCounters->Enter(OuelletHullPhaseSearch);
+		}
+
+		for (count_t n = 0; n < blockCount; n++)
+		{
+			ProcessPoint(pBlock[n]);
+		}
+	}
+
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(-1);
+	}
+}
+
+// **************************************************************************
+// Vertex of a quadrant hull that spans the biggest rectangle with center
+template <typename TPoint>
+static const TPoint& GetInnerCorner(const TPoint* pHullPoints, count_t hullCount, const point& center)
+{
+	count_t indexBest = 0;
+	double areaBest = -1;
+	for (count_t n = 0; n < hullCount; n++)
+	{
+		double area = fabs((pHullPoints[n].x - center.x) * (pHullPoints[n].y - center.y));
+		if (area > areaBest)
+		{
+			areaBest = area;
+			indexBest = n;
+		}
+	}
+
+	return pHullPoints[indexBest];
+}
+
+// **************************************************************************
+// Axis aligned box strictly inside the current quadrant hulls: each side of the box is under the segment between
+// the two quadrant vertices that bound it, so a point strictly inside the box can't be a hull point.
+template <typename TPoint>
+bool OuelletHullOf<TPoint>::GetInnerBox(point& innerMin, point& innerMax)
+{
+	point center = { (q1pHullPoints[0].x + q3pHullPoints[0].x) / 2, (q1pHullPoints[q1hullCount - 1].y + q3pHullPoints[q3hullCount - 1].y) / 2 };
+
+	const TPoint& q1Corner = GetInnerCorner(q1pHullPoints, q1hullCount, center);
+	const TPoint& q2Corner = GetInnerCorner(q2pHullPoints, q2hullCount, center);
+	const TPoint& q3Corner = GetInnerCorner(q3pHullPoints, q3hullCount, center);
+	const TPoint& q4Corner = GetInnerCorner(q4pHullPoints, q4hullCount, center);
+
+	innerMin.x = q2Corner.x > q3Corner.x ? q2Corner.x : q3Corner.x;
+	innerMax.x = q1Corner.x < q4Corner.x ? q1Corner.x : q4Corner.x;
+	innerMin.y = q3Corner.y > q4Corner.y ? q3Corner.y : q4Corner.y;
+	innerMax.y = q1Corner.y < q2Corner.y ? q1Corner.y : q2Corner.y;
+
+	return innerMin.x < innerMax.x && innerMin.y < innerMax.y;
+}
+
+// **************************************************************************
+// Add pt to the quadrant hull(s) it belongs to, if it is outside of them
+template <typename TPoint>
+void OuelletHullOf<TPoint>::ProcessPoint(TPoint& pt)
+{
+	count_t index;
+	count_t indexLow;
+	count_t indexHi;
+
+	// ****************************************************************
+	// Q1 Calc
+	// ****************************************************************
+
+	// Begin get insertion point
+	if (pt.x > q1rootPt.x && pt.y > q1rootPt.y) // Is point is in Q1
+	{
+		indexLow = 0;
+		indexHi = q1hullCount;
+
+		while (indexLow < indexHi - 1)
+		{
+			index = ((indexHi - indexLow) >> 1) + indexLow;
+
+			if (pt.x <= q1pHullPoints[index].x && pt.y <= q1pHullPoints[index].y)
+			{
+				goto currentPointNotPartOfq1Hull; // No calc needed
+			}
+
+			if (pt.x > q1pHullPoints[index].x)
+			{
+				indexHi = index;
+				continue;
+			}
+
+			if (pt.x < q1pHullPoints[index].x)
+			{
+				indexLow = index;
+				continue;
+			}
+
+			indexLow = index - 1;
+			indexHi = index + 1;
+			break;
+		}
+
+		// Here indexLow should contains the index where the point should be inserted 
+		// if calculation does not invalidate it.
+
+		if (!right_turn(q1pHullPoints[indexLow], q1pHullPoints[indexHi], pt))
+		{
+			goto currentPointNotPartOfq1Hull;
+		}
+
+		// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
+
+		// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// But indexLow and indexHi can change because it could invalidate many points before or after.
+
+		// Find lower bound (remove point invalidate by the new one that come before)
+		while (indexLow > 0)
+		{
+			if (right_turn(q1pHullPoints[indexLow - 1], pt, q1pHullPoints[indexLow]))
+			{
+				break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
+			}
+			indexLow--;
+		}
+
+		// Find upper bound (remove point invalidate by the new one that come after)
+		count_t maxIndexHi = q1hullCount - 1;
+		while (indexHi < maxIndexHi)
+		{
+			if (right_turn(pt, q1pHullPoints[indexHi + 1], q1pHullPoints[indexHi]))
+			{
+				break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
+			}
+			indexHi++;
+		}
+
+		if (indexLow + 1 == indexHi)
+		{
+			InsertPoint(q1pHullPoints, indexLow + 1, pt, q1hullCount, q1hullCapacity);
+
+			return;
+		}
+		else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
+		{
+			q1pHullPoints[indexLow + 1] = pt;
+			return;
+		}
+		else
+		{
+			q1pHullPoints[indexLow + 1] = pt;
+			RemoveRange(q1pHullPoints, indexLow + 2, indexHi -1, q1hullCount);
+			return;
+		}
+	}
+
+currentPointNotPartOfq1Hull:
+
+	// ****************************************************************
+	// Q2 Calc
+	// ****************************************************************
+
+	// Begin get insertion point
+	if (pt.x < q2rootPt.x && pt.y > q2rootPt.y) // Is point is in q2
+	{
+		indexLow = 0;
+		indexHi = q2hullCount;
+
+		while (indexLow < indexHi - 1)
+		{
+			index = ((indexHi - indexLow) >> 1) + indexLow;
+
+			if (pt.x >= q2pHullPoints[index].x && pt.y <= q2pHullPoints[index].y)
+			{
+				goto currentPointNotPartOfq2Hull; // No calc needed
+			}
+
+			if (pt.x > q2pHullPoints[index].x)
+			{
+				indexHi = index;
+				continue;
+			}
+
+			if (pt.x < q2pHullPoints[index].x)				{
+				indexLow = index;
+				continue;
+			}
+
+			indexLow = index - 1;
+			indexHi = index + 1;
+			break;
+		}
+
+		// Here indexLow should contains the index where the point should be inserted 
+		// if calculation does not invalidate it.
+
+		if (!right_turn(q2pHullPoints[indexLow], q2pHullPoints[indexHi], pt))
+		{
+			goto currentPointNotPartOfq2Hull;
+		}
+
+		// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
+
+		// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// But indexLow and indexHi can change because it could invalidate many points before or after.
+
+		// Find lower bound (remove point invalidate by the new one that come before)
+		while (indexLow > 0)
+		{
+			if (right_turn(q2pHullPoints[indexLow - 1], pt, q2pHullPoints[indexLow]))
+			{
+				break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
+			}
+			indexLow--;
+		}
+
+		// Find upper bound (remove point invalidate by the new one that come after)
+		count_t maxIndexHi = q2hullCount - 1;
+		while (indexHi < maxIndexHi)
+		{
+			if (right_turn(pt, q2pHullPoints[indexHi + 1], q2pHullPoints[indexHi]))
+			{
+				break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
+			}
+			indexHi++;
+		}
+
+		if (indexLow + 1 == indexHi)
+		{
+			InsertPoint(q2pHullPoints, indexLow + 1, pt, q2hullCount, q2hullCapacity);
+
+			return;
+		}
+		else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
+		{
+			q2pHullPoints[indexLow + 1] = pt;
+			return;
+		}
+		else
+		{
+			q2pHullPoints[indexLow + 1] = pt;
+			RemoveRange(q2pHullPoints, indexLow + 2, indexHi - 1, q2hullCount);
+			return;
+		}
+	}
+
+currentPointNotPartOfq2Hull:
+
+	// ****************************************************************
+	// Q3 Calc
+	// ****************************************************************
+
+	// Begin get insertion point
+	if (pt.x < q3rootPt.x && pt.y < q3rootPt.y) // Is point is in q3
+	{
+		indexLow = 0;
+		indexHi = q3hullCount;
+
+		while (indexLow < indexHi - 1)
+		{
+			index = ((indexHi - indexLow) >> 1) + indexLow;
+
+			if (pt.x >= q3pHullPoints[index].x && pt.y >= q3pHullPoints[index].y)
+			{
+				goto currentPointNotPartOfq3Hull; // No calc needed
+			}
+
+			if (pt.x < q3pHullPoints[index].x)
+			{
+				indexHi = index;
+				continue;
+			}
+
+			if (pt.x > q3pHullPoints[index].x)
+			{
+				indexLow = index;
+				continue;
+			}
+
+			indexLow = index - 1;
+			indexHi = index + 1;
+			break;
+		}
+
+		// Here indexLow should contains the index where the point should be inserted 
+		// if calculation does not invalidate it.
+
+		if (!right_turn(q3pHullPoints[indexLow], q3pHullPoints[indexHi], pt))
+		{
+			goto currentPointNotPartOfq3Hull;
+		}
+
+		// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
+
+		// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// But indexLow and indexHi can change because it could invalidate many points before or after.
+
+		// Find lower bound (remove point invalidate by the new one that come before)
+		while (indexLow > 0)
+		{
+			if (right_turn(q3pHullPoints[indexLow - 1], pt, q3pHullPoints[indexLow]))
+			{
+				break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
+			}
+			indexLow--;
+		}
+
+		// Find upper bound (remove point invalidate by the new one that come after)
+		count_t maxIndexHi = q3hullCount - 1;
+		while (indexHi < maxIndexHi)
+		{
+			if (right_turn(pt, q3pHullPoints[indexHi + 1], q3pHullPoints[indexHi]))
+			{
+				break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
+			}
+			indexHi++;
+		}
+
+		if (indexLow + 1 == indexHi)
+		{
+			InsertPoint(q3pHullPoints, indexLow + 1, pt, q3hullCount, q3hullCapacity);
+
+			return;
+		}
+		else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
+		{
+			q3pHullPoints[indexLow + 1] = pt;
+			return;
+		}
+		else
+		{
+			q3pHullPoints[indexLow + 1] = pt;
+			RemoveRange(q3pHullPoints, indexLow + 2, indexHi - 1, q3hullCount);
+			return;
+		}
+	}
+
+currentPointNotPartOfq3Hull:
+
+	// ****************************************************************
+	// Q4 Calc
+	// ****************************************************************
+
+	// Begin get insertion point
+	if (pt.x > q4rootPt.x && pt.y < q4rootPt.y) // Is point is in q4
+	{
+		indexLow = 0;
+		indexHi = q4hullCount;
+
+		while (indexLow < indexHi - 1)
+		{
+			index = ((indexHi - indexLow) >> 1) + indexLow;
+
+			if (pt.x <= q4pHullPoints[index].x && pt.y >= q4pHullPoints[index].y)
+			{
+				goto currentPointNotPartOfq4Hull; // No calc needed
+			}
+
+			if (pt.x < q4pHullPoints[index].x)
+			{
+				indexHi = index;
+				continue;
+			}
+
+			if (pt.x > q4pHullPoints[index].x)
+			{
+				indexLow = index;
+				continue;
+			}
+
+			indexLow = index - 1;
+			indexHi = index + 1;
+			break;
+		}
+
+		// Here indexLow should contains the index where the point should be inserted 
+		// if calculation does not invalidate it.
+
+		if (!right_turn(q4pHullPoints[indexLow], q4pHullPoints[indexHi], pt))
+		{
+			goto currentPointNotPartOfq4Hull;
+		}
+
+		// HERE: We should insert a new candidate as a Hull Point (until a new one could invalidate this one, if any).
+
+		// indexLow is the index of the point before the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// indexHi is the index of the point after the place where the new point should be inserted as the new candidate of ConveHull Point.
+		// But indexLow and indexHi can change because it could invalidate many points before or after.
+
+		// Find lower bound (remove point invalidate by the new one that come before)
+		while (indexLow > 0)
+		{
+			if (right_turn(q4pHullPoints[indexLow - 1], pt, q4pHullPoints[indexLow]))
+			{
+				break; // We found the lower index limit of points to keep. The new point should be added right after indexLow.
+			}
+			indexLow--;
+		}
+
+		// Find upper bound (remove point invalidate by the new one that come after)
+		count_t maxIndexHi = q4hullCount - 1;
+		while (indexHi < maxIndexHi)
+		{
+			if (right_turn(pt, q4pHullPoints[indexHi + 1], q4pHullPoints[indexHi]))
+			{
+				break; // We found the higher index limit of points to keep. The new point should be added right before indexHi.
+			}
+			indexHi++;
+		}
+
+		if (indexLow + 1 == indexHi)
+		{
+			InsertPoint(q4pHullPoints, indexLow + 1, pt, q4hullCount, q4hullCapacity);
+
+			return;
+		}
+		else if (indexLow + 2 == indexHi) // Don't need to insert, just replace at index + 1
+		{
+			q4pHullPoints[indexLow + 1] = pt;
+			return;
+		}
+		else
+		{
+			q4pHullPoints[indexLow + 1] = pt;
+			RemoveRange(q4pHullPoints, indexLow + 2, indexHi - 1, q4hullCount);
+			return;
+		}
+	}
+
+currentPointNotPartOfq4Hull:
+	return; // All quadrant are done
+}
+
+// **************************************************************************
+template <typename TPoint>
+void OuelletHullOf<TPoint>::InsertPoint(TPoint*& pPoint, count_t index, TPoint& pt, count_t& count, count_t& capacity)
+{
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(OuelletHullPhaseMove);
+	}
+
+	// make some room to insert the point. make sure to not reach capacity and/or adjust it
+	if (count >= capacity)
+	{
+		// Should make some room
+		//int newCapacity = capacity + _quadrantHullPointArrayGrowSize; // Very bad in the worse case. Fallback to regular way of growing list capacity
+		count_t newCapacity = capacity * 2;
+		TPoint* newPointArray = new TPoint[newCapacity];
+		memmove(newPointArray, pPoint, capacity * sizeof(TPoint));
+		delete[] pPoint;
+		pPoint = newPointArray;
+		capacity = newCapacity;
+	}
+	
+	memmove(&(pPoint[index + 1]), &(pPoint[index]), (count - index) * sizeof(TPoint));
+
+	// Insert Point at index 
+	pPoint[index] = pt;
+	count++;
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(OuelletHullPhaseSearch);
+	}
+}
+
+// **************************************************************************
+/// Remove every item in from index start to indexEnd inclusive 
+template <typename TPoint>
+void OuelletHullOf<TPoint>::RemoveRange(TPoint* pPoint, count_t indexStart, count_t indexEnd, count_t &count)
+{
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(OuelletHullPhaseMove);
+	}
+
+	memmove(&(pPoint[indexStart]), &(pPoint[indexEnd + 1]), (count - indexEnd) * sizeof(TPoint));
+	count -= (indexEnd - indexStart + 1);
+
+	if (_pPhaseCounters != NULL)
+	{
+		_pPhaseCounters->Enter(OuelletHullPhaseSearch);
+	}
+}
+
+// **************************************************************************
+template <typename TPoint>
+OuelletHullOf<TPoint>::OuelletHullOf(TPoint* points, count_t countOfPoint, bool shouldCloseTheGraph)
+{
+	_pPoints = points;
+	_countOfPoint = countOfPoint;
+	_shouldCloseTheGraph = shouldCloseTheGraph;
+
+	CalcConvexHull();
+}
+
+// **************************************************************************
+template <typename TPoint>
+OuelletHullOf<TPoint>::OuelletHullOf(TPoint* points, count_t countOfPoint, const int64_t* pSeedIndexes, count_t seedCount, bool shouldCloseTheGraph)
+{
+	_pPoints = points;
+	_countOfPoint = countOfPoint;
+	_shouldCloseTheGraph = shouldCloseTheGraph;
+	_pSeedIndexes = pSeedIndexes;
+	_seedCount = seedCount;
+
+	CalcConvexHull();
+}
+
+// **************************************************************************
+template <typename TPoint>
+OuelletHullOf<TPoint>::OuelletHullOf(TPoint* points, count_t countOfPoint, bool shouldCloseTheGraph, PerfPhaseCounters* pPhaseCounters)
+{
+	_pPoints = points;
+	_countOfPoint = countOfPoint;
+	_shouldCloseTheGraph = shouldCloseTheGraph;
+	_pPhaseCounters = pPhaseCounters;
+
+	CalcConvexHull();
+}
+
+// **************************************************************************
+template <typename TPoint>
+OuelletHullOf<TPoint>::OuelletHullOf(TPoint* points, count_t countOfPoint, bool shouldCloseTheGraph, bool isSinglePass,
+	PerfPhaseCounters* pPhaseCounters)
+{
+	_pPoints = points;
+	_countOfPoint = countOfPoint;
+	_shouldCloseTheGraph = shouldCloseTheGraph;
+	_isSinglePass = isSinglePass;
+	_pPhaseCounters = pPhaseCounters;
+
+	CalcConvexHull();
+}
+
+// **************************************************************************
+template <typename TPoint>
+OuelletHullOf<TPoint>::~OuelletHullOf()
+{
+	delete[] q1pHullPoints;
+	delete[] q2pHullPoints;
+	delete[] q3pHullPoints;
+	delete[] q4pHullPoints;
+}
+
+// **************************************************************************
+template <typename TPoint>
+TPoint* OuelletHullOf<TPoint>::GetResultAsArray(int& hullPointCount)
+{
+	int64_t count;
+	TPoint* results = GetResultAsArray(count);
+	hullPointCount = (int)count;
+	return results;
+}
+
+// **************************************************************************
+// First and last index in each quadrant hull of its vertices in the result: a vertex shared by two quadrants is
+// kept once. Returns the count of vertices of the result (not closed), pointLast is its last vertex.
+template <typename TPoint>
+count_t OuelletHullOf<TPoint>::GetResultRanges(count_t* pIndexStarts, count_t* pIndexEnds, TPoint& pointLast)
+{
+	count_t indexQ1Start;
+	count_t indexQ2Start;
+	count_t indexQ3Start;
+	count_t indexQ4Start;
+	count_t indexQ1End;
+	count_t indexQ2End;
+	count_t indexQ3End;
+	count_t indexQ4End;
+
+	indexQ1Start = 0;
+	indexQ1End = q1hullCount - 1;
+	pointLast = q1pHullPoints[indexQ1End];
+
+	if (q2hullCount == 1)
+	{
+		if (compare_points(*q2pHullPoints, pointLast)) // 
+		{
+			indexQ2Start = 1;
+			indexQ2End = 0;
+		}
+		else
+		{
+			indexQ2Start = 0;
+			indexQ2End = 0;
+			pointLast = *q2pHullPoints;
+		}
+	}
+	else
+	{
+		if (compare_points(*q2pHullPoints, pointLast))
+		{
+			indexQ2Start = 1;
+		}
+		else
+		{
+			indexQ2Start = 0;
+		}
+		indexQ2End = q2hullCount - 1;
+		pointLast = q2pHullPoints[indexQ2End];
+	}
+
+	if (q3hullCount == 1)
+	{
+		if (compare_points(*q3pHullPoints, pointLast))
+		{
+			indexQ3Start = 1;
+			indexQ3End = 0;
+		}
+		else
+		{
+			indexQ3Start = 0;
+			indexQ3End = 0;
+			pointLast = *q3pHullPoints;
+		}
+	}
+	else
+	{
+		if (compare_points(*q3pHullPoints, pointLast))
+		{
+			indexQ3Start = 1;
+		}
+		else
+		{
+			indexQ3Start = 0;
+		}
+		indexQ3End = q3hullCount - 1;
+		pointLast = q3pHullPoints[indexQ3End];
+	}
+
+	if (q4hullCount == 1)
+	{
+		if (compare_points(*q4pHullPoints, pointLast))
+		{
+			indexQ4Start = 1;
+			indexQ4End = 0;
+		}
+		else
+		{
+			indexQ4Start = 0;
+			indexQ4End = 0;
+			pointLast = *q4pHullPoints;
+		}
+	}
+	else
+	{
+		if (compare_points(*q4pHullPoints, pointLast))
+		{
+			indexQ4Start = 1;
+		}
+		else
+		{
+			indexQ4Start = 0;
+		}
+
+		indexQ4End = q4hullCount - 1;
+		pointLast = q4pHullPoints[indexQ4End];
+	}
+
+	if (compare_points(q1pHullPoints[indexQ1Start], pointLast))
+	{
+		indexQ1Start++;
+	}
+
+	pIndexStarts[0] = indexQ1Start;
+	pIndexStarts[1] = indexQ2Start;
+	pIndexStarts[2] = indexQ3Start;
+	pIndexStarts[3] = indexQ4Start;
+	pIndexEnds[0] = indexQ1End;
+	pIndexEnds[1] = indexQ2End;
+	pIndexEnds[2] = indexQ3End;
+	pIndexEnds[3] = indexQ4End;
+
+	return (indexQ1End - indexQ1Start) +
+		(indexQ2End - indexQ2Start) +
+		(indexQ3End - indexQ3Start) +
+		(indexQ4End - indexQ4Start) + 4;
+}
+
+// **************************************************************************
+template <typename TPoint>
+TPoint* OuelletHullOf<TPoint>::GetResultAsArray(int64_t& hullPointCount)
+{
+	hullPointCount = 0;
+	if (this->_countOfPoint == 0)
+	{
+		return NULL;
+	}
+
+	count_t indexStarts[4];
+	count_t indexEnds[4];
+	TPoint pointLast;
+	count_t countOfFinalHullPoint = GetResultRanges(indexStarts, indexEnds, pointLast);
+
+	if (countOfFinalHullPoint <= 1) // Case where there is only one point or many of only the same point. Auto closed if required.
+	{
+		return new TPoint[1]{ pointLast };
+	}
+
+	if (countOfFinalHullPoint > 1 && _shouldCloseTheGraph)
+	{
+		countOfFinalHullPoint++;
+	}
+
+	TPoint* results = new TPoint[countOfFinalHullPoint];
+
+	count_t resIndex = 0;
+
+	for (count_t n = indexStarts[0]; n <= indexEnds[0]; n++)
+	{
+		results[resIndex] = q1pHullPoints[n];
+		resIndex++;
+	}
+
+	for (count_t n = indexStarts[1]; n <= indexEnds[1]; n++)
+	{
+		results[resIndex] = q2pHullPoints[n];
+		resIndex++;
+	}
+
+	for (count_t n = indexStarts[2]; n <= indexEnds[2]; n++)
+	{
+		results[resIndex] = q3pHullPoints[n];
+		resIndex++;
+	}
+
+	for (count_t n = indexStarts[3]; n <= indexEnds[3]; n++)
+	{
+		results[resIndex] = q4pHullPoints[n];
+		resIndex++;
+	}
+
+	if (countOfFinalHullPoint > 1 && _shouldCloseTheGraph)
+	{
+		results[resIndex] = results[0];
+	}
+
+	hullPointCount = countOfFinalHullPoint;
+
+	return results;
+}
+
+// **************************************************************************
+// Slot of the open addressing table of MoveResultToFront: a vertex and its index in the result
+struct HullVertexSlot
+{
+	number x;
+	number y;
+	count_t resultIndex; // -1 for an empty slot
+};
+
+// **************************************************************************
+static inline count_t HullVertexHash(number x, number y, int slotBits)
+{
+	x += 0.0; // -0 made 0
+	y += 0.0;
+	uint64_t bitsX;
+	uint64_t bitsY;
+	memcpy(&bitsX, &x, sizeof(bitsX));
+	memcpy(&bitsY, &y, sizeof(bitsY));
+	return (count_t)(((bitsX ^ (bitsY * 0xC2B2AE3D27D4EB4Full)) * 0x9E3779B97F4A7C15ull) >> (64 - slotBits));
+}
+
+// **************************************************************************
+// The quadrant hulls hold the vertices in the order of the result: they go in a hash table with their index in
+// the result. Each point out of the inner box is looked up, a vertex is swapped to its index and the point that
+// comes back is looked at the same way. A place that already holds the vertex (moved or there from the start) is
+// left as is: other copies of it stay behind. At most one swap by vertex, the table is the only allocation
+// (O(h)). Points keep their exact values (-0 is not made 0).
+template <typename TPoint>
+count_t OuelletHullOf<TPoint>::MoveResultToFront()
+{
+	if (_countOfPoint == 0)
+	{
+		return 0;
+	}
+
+	count_t indexStarts[4];
+	count_t indexEnds[4];
+	TPoint pointLast;
+	count_t hullCount = GetResultRanges(indexStarts, indexEnds, pointLast);
+	if (hullCount <= 1)
+	{
+		return 0; // The points are all the same: no vertex, as GetResultAsArray
+	}
+
+	int slotBits = 1;
+	while (((count_t)1 << slotBits) < 2 * hullCount)
+	{
+		slotBits++;
+	}
+	count_t slotMask = ((count_t)1 << slotBits) - 1;
+	HullVertexSlot* pSlots = new HullVertexSlot[slotMask + 1];
+	for (count_t n = 0; n <= slotMask; n++)
+	{
+		pSlots[n].resultIndex = -1;
+	}
+
+	const TPoint* quadrantHullPoints[4] = { q1pHullPoints, q2pHullPoints, q3pHullPoints, q4pHullPoints };
+	count_t resultIndex = 0;
+	for (int quadrant = 0; quadrant < 4; quadrant++)
+	{
+		for (count_t n = indexStarts[quadrant]; n <= indexEnds[quadrant]; n++)
+		{
+			const TPoint& vertex = quadrantHullPoints[quadrant][n];
+			count_t slot = HullVertexHash(vertex.x, vertex.y, slotBits);
+			while (pSlots[slot].resultIndex >= 0)
+			{
+				slot = (slot + 1) & slotMask;
+			}
+			pSlots[slot].x = vertex.x;
+			pSlots[slot].y = vertex.y;
+			pSlots[slot].resultIndex = resultIndex++;
+		}
+	}
+
+	point innerMin;
+	point innerMax;
+	bool hasInnerBox = GetInnerBox(innerMin, innerMax);
+
+	for (count_t n = 0; n < _countOfPoint; n++)
+	{
+		TPoint& pt = _pPoints[n];
+		for (;;)
+		{
+			if (hasInnerBox && pt.x > innerMin.x && pt.x < innerMax.x && pt.y > innerMin.y && pt.y < innerMax.y)
+			{
+				break;
+			}
+
+			count_t slot = HullVertexHash(pt.x, pt.y, slotBits);
+			while (pSlots[slot].resultIndex >= 0 && (pSlots[slot].x != pt.x || pSlots[slot].y != pt.y))
+			{
+				slot = (slot + 1) & slotMask;
+			}
+
+			count_t index = pSlots[slot].resultIndex;
+			if (index < 0 || index == n)
+			{
+				break;
+			}
+
+			TPoint& place = _pPoints[index];
+			if (place.x == pt.x && place.y == pt.y)
+			{
+				break;
+			}
+
+			std::swap(pt, place);
+		}
+	}
+
+	delete[] pSlots;
+	return hullCount;
+}
+
+// **************************************************************************
@@ -0,0 +1,107 @@
+#include "Stdafx.h"
+#include "OuelletHullStream.h"
+#include "OuelletHull.h"
+#include <string.h>
+
+#pragma managed(push, off)
+
+// **************************************************************************
+OuelletHullStream::OuelletHullStream()
+{
+}
+
+// **************************************************************************
+OuelletHullStream::~OuelletHullStream()
+{
+	delete[] _pCandidates;
+	delete[] _pBuffer;
+}
+
+// **************************************************************************
+void OuelletHullStream::Begin()
+{
+	delete[] _pCandidates;
+	_pCandidates = NULL;
+	_candidateCount = 0;
+}
+
+// **************************************************************************
+void OuelletHullStream::Feed(const point* pPoints, int64_t count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	count_t bufferCount = _candidateCount + (count_t)count;
+	if (bufferCount > _bufferCapacity)
+	{
+		delete[] _pBuffer;
+		_bufferCapacity = bufferCount * 2;
+		_pBuffer = new point[_bufferCapacity];
+	}
+
+	if (_candidateCount > 0)
+	{
+		memcpy(_pBuffer, _pCandidates, _candidateCount * sizeof(point));
+	}
+	memcpy(_pBuffer + _candidateCount, pPoints, (size_t)count * sizeof(point));
+
+	int64_t candidateCount;
+	OuelletHull convexHull(_pBuffer, bufferCount, false);
+	point* pCandidates = convexHull.GetResultAsArray(candidateCount);
+
+	// All points the same: OuelletHull gives no point, one is kept for the next chunks
+	if (candidateCount == 0)
+	{
+		delete[] pCandidates;
+		pCandidates = new point[1];
+		pCandidates[0] = _pBuffer[0];
+		candidateCount = 1;
+	}
+
+	delete[] _pCandidates;
+	_pCandidates = pCandidates;
+	_candidateCount = (count_t)candidateCount;
+}
+
+// **************************************************************************
+point* OuelletHullStream::Finish(bool closeThePath, int64_t& resultCount)
+{
+	point* results = NULL;
+	resultCount = 0;
+
+	// Also closes the path and gives no point for a single one, as the one shot call
+	if (_candidateCount > 0)
+	{
+		OuelletHull convexHull(_pCandidates, _candidateCount, closeThePath);
+		results = convexHull.GetResultAsArray(resultCount);
+	}
+
+	Begin();
+	return results;
+}
+
+// **************************************************************************
+extern "C" OuelletHullStream* ouelletHullStreamBegin()
+{
+	return new OuelletHullStream();
+}
+
+// **************************************************************************
+extern "C" void ouelletHullStreamFeed(OuelletHullStream* pStream, const point* pPoints, int64_t count)
+{
+	pStream->Feed(pPoints, count);
+}
+
+// **************************************************************************
+extern "C" point* ouelletHullStreamFinish(OuelletHullStream* pStream, bool closeThePath, int64_t& resultCount)
+{
+	point* results = pStream->Finish(closeThePath, resultCount);
+	delete pStream;
+	return results;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
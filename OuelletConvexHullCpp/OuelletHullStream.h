@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Point.h"
+
+// OuelletHull of points that come by chunks (socket, file), without keeping them: between chunks only the hull
+// vertices so far (the quadrant hull candidates) are kept. Feed runs OuelletHull on them followed by the chunk:
+// the candidates go first, in hull order (appended at the end of the quadrant arrays, no move), then most points
+// of the chunk are rejected by the quadrant hulls they already make. The hull of the candidates and the chunk is
+// the hull of all points so far, so the result is the one of ouelletHull64 on all points. Memory is O(chunk + h).
+class OuelletHullStream
+{
+private:
+	point* _pCandidates = NULL; // Hull so far, not closed (one point when all points so far are the same)
+	count_t _candidateCount = 0;
+	point* _pBuffer = NULL; // Candidates then chunk, reused by the next feeds
+	count_t _bufferCapacity = 0;
+
+public:
+	OuelletHullStream();
+	~OuelletHullStream();
+
+	void Begin(); // Forgets the points fed so far
+	void Feed(const point* pPoints, int64_t count);
+	point* Finish(bool closeThePath, int64_t& resultCount); // Same as ouelletHull64, free with delete[]. Then Begin again.
+};
+
+extern "C"
+{
+	OuelletHullStream* ouelletHullStreamBegin();
+	void ouelletHullStreamFeed(OuelletHullStream* pStream, const point* pPoints, int64_t count);
+	// The stream is deleted
+	point* ouelletHullStreamFinish(OuelletHullStream* pStream, bool closeThePath, int64_t& resultCount);
+}
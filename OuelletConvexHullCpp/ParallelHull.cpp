@@ -0,0 +1,513 @@
+#include "ParallelHull.h"
+#include "TaskScheduler.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <omp.h>
+
+// Smallest chunk of points given to a task
+#define PARALLEL_HULL_GRAIN_SIZE 32768
+
+// Subproblems done with a monotone chain
+#define PARALLEL_HULL_LEAF_SIZE 65536
+
+// Points of the divide and conquer sample giving the median x
+#define PARALLEL_HULL_SAMPLE_SIZE 255
+
+// Lower and upper chains of a hull, both from the leftmost (then lowest) to the rightmost (then highest) vertex
+struct HullChains
+{
+	std::vector<point> lower;
+	std::vector<point> upper;
+};
+
+// **************************************************************************
+// Body is called once per index, on tasks made by halving the range (a thief gets the biggest half)
+template <typename Body>
+static void ParallelFor(TaskScheduler& scheduler, count_t begin, count_t end, const Body& body)
+{
+	if (end - begin <= 1)
+	{
+		if (end > begin)
+		{
+			body(begin);
+		}
+		return;
+	}
+
+	count_t middle = begin + (end - begin) / 2;
+	TaskGroup group(scheduler);
+	group.Spawn([&scheduler, middle, end, &body]() { ParallelFor(scheduler, middle, end, body); });
+	ParallelFor(scheduler, begin, middle, body);
+	group.Wait();
+}
+
+// **************************************************************************
+// At least PARALLEL_HULL_GRAIN_SIZE points per chunk, a few chunks per thread to balance the load
+static count_t ChunkCount(TaskScheduler& scheduler, count_t count)
+{
+	return std::min(count / PARALLEL_HULL_GRAIN_SIZE + 1, (count_t)scheduler.ThreadCount() * 4);
+}
+
+// **************************************************************************
+static count_t ChunkBegin(count_t count, count_t chunkCount, count_t chunk)
+{
+	return (count_t)((double)count * chunk / chunkCount);
+}
+
+// **************************************************************************
+// Copies the points classified 0 to pFirst and the ones classified 1 to pSecond (NULL: right after the first
+// ones), drops the others. Order is kept. Chunks are classified, then each one writes at its offset.
+template <typename Classify>
+static void ParallelSplit(TaskScheduler& scheduler, const point* pPoints, count_t count, const Classify& classify,
+	point* pFirst, count_t& firstCount, point* pSecond, count_t& secondCount)
+{
+	count_t chunkCount = ChunkCount(scheduler, count);
+	std::vector<count_t> firstOffsets(chunkCount + 1, 0);
+	std::vector<count_t> secondOffsets(chunkCount + 1, 0);
+	signed char* pSides = new signed char[count];
+
+	ParallelFor(scheduler, 0, chunkCount, [&](count_t chunk)
+	{
+		count_t first = 0;
+		count_t second = 0;
+		for (count_t n = ChunkBegin(count, chunkCount, chunk); n < ChunkBegin(count, chunkCount, chunk + 1); n++)
+		{
+			int side = classify(pPoints[n]);
+			pSides[n] = (signed char)side;
+			first += side == 0;
+			second += side == 1;
+		}
+		firstOffsets[chunk + 1] = first;
+		secondOffsets[chunk + 1] = second;
+	});
+
+	for (count_t chunk = 0; chunk < chunkCount; chunk++)
+	{
+		firstOffsets[chunk + 1] += firstOffsets[chunk];
+		secondOffsets[chunk + 1] += secondOffsets[chunk];
+	}
+	firstCount = firstOffsets[chunkCount];
+	secondCount = secondOffsets[chunkCount];
+	if (pSecond == NULL)
+	{
+		pSecond = pFirst + firstCount;
+	}
+
+	ParallelFor(scheduler, 0, chunkCount, [&](count_t chunk)
+	{
+		point* pFirstOut = pFirst + firstOffsets[chunk];
+		point* pSecondOut = pSecond + secondOffsets[chunk];
+		for (count_t n = ChunkBegin(count, chunkCount, chunk); n < ChunkBegin(count, chunkCount, chunk + 1); n++)
+		{
+			if (pSides[n] == 0)
+			{
+				*pFirstOut++ = pPoints[n];
+			}
+			else if (pSides[n] == 1)
+			{
+				*pSecondOut++ = pPoints[n];
+			}
+		}
+	});
+
+	delete[] pSides;
+}
+
+// **************************************************************************
+// Monotone chain on points sorted by x then y, copies are skipped
+static void SortedChains(const point* pPoints, count_t count, HullChains& chains)
+{
+	chains.lower.clear();
+	chains.upper.clear();
+	for (count_t n = 0; n < count; n++)
+	{
+		const point& pt = pPoints[n];
+		if (!chains.lower.empty() && compare_points(chains.lower.back(), pt))
+		{
+			continue;
+		}
+
+		while (chains.lower.size() >= 2 && area(chains.lower[chains.lower.size() - 2], chains.lower.back(), pt) <= 0)
+		{
+			chains.lower.pop_back();
+		}
+		chains.lower.push_back(pt);
+
+		while (chains.upper.size() >= 2 && area(chains.upper[chains.upper.size() - 2], chains.upper.back(), pt) >= 0)
+		{
+			chains.upper.pop_back();
+		}
+		chains.upper.push_back(pt);
+	}
+}
+
+// **************************************************************************
+static void LeafChains(point* pPoints, count_t count, HullChains& chains)
+{
+	std::sort(pPoints, pPoints + count, [](const point& a, const point& b) { return cmp(a, b) < 0; });
+	SortedChains(pPoints, count, chains);
+}
+
+// **************************************************************************
+// Tangent of two chains split by x: walks back on the left one and forward on the right one while the next
+// vertex is below the line (side 1, lower chains) or above it (side -1, upper chains). Collinear vertices
+// are passed too, only strict vertices are kept.
+static void ChainTangent(const std::vector<point>& left, const std::vector<point>& right, int side, size_t& leftIndex, size_t& rightIndex)
+{
+	leftIndex = left.size() - 1;
+	rightIndex = 0;
+
+	bool isMoving = true;
+	while (isMoving)
+	{
+		isMoving = false;
+		while (leftIndex > 0 && side * area(left[leftIndex], right[rightIndex], left[leftIndex - 1]) <= 0)
+		{
+			leftIndex--;
+			isMoving = true;
+		}
+		while (rightIndex + 1 < right.size() && side * area(left[leftIndex], right[rightIndex], right[rightIndex + 1]) <= 0)
+		{
+			rightIndex++;
+			isMoving = true;
+		}
+	}
+}
+
+// **************************************************************************
+// Hull of two hulls split by x (all points of left before the ones of right), in left. O(h).
+static void MergeChains(HullChains& left, const HullChains& right)
+{
+	size_t leftIndex, rightIndex;
+
+	ChainTangent(left.lower, right.lower, 1, leftIndex, rightIndex);
+	left.lower.resize(leftIndex + 1);
+	left.lower.insert(left.lower.end(), right.lower.begin() + rightIndex, right.lower.end());
+
+	ChainTangent(left.upper, right.upper, -1, leftIndex, rightIndex);
+	left.upper.resize(leftIndex + 1);
+	left.upper.insert(left.upper.end(), right.upper.begin() + rightIndex, right.upper.end());
+}
+
+// **************************************************************************
+// pPoints and pScratch are both modified, the chains of the hull are in chains
+static void DivideAndConquerHull(TaskScheduler& scheduler, point* pPoints, point* pScratch, count_t count, HullChains& chains)
+{
+	if (count <= PARALLEL_HULL_LEAF_SIZE)
+	{
+		LeafChains(pPoints, count, chains);
+		return;
+	}
+
+	double sample[PARALLEL_HULL_SAMPLE_SIZE];
+	count_t stride = count / PARALLEL_HULL_SAMPLE_SIZE;
+	for (int n = 0; n < PARALLEL_HULL_SAMPLE_SIZE; n++)
+	{
+		sample[n] = pPoints[n * stride].x;
+	}
+	std::nth_element(sample, sample + PARALLEL_HULL_SAMPLE_SIZE / 2, sample + PARALLEL_HULL_SAMPLE_SIZE);
+	double pivot = sample[PARALLEL_HULL_SAMPLE_SIZE / 2];
+
+	// Pivot is the x of a point: there is a point on the right, then if pivot is the smallest x, on the left
+	// with <=. All points have the same x if there is none on the right with <=.
+	count_t leftCount, rightCount;
+	ParallelSplit(scheduler, pPoints, count, [pivot](const point& pt) { return pt.x < pivot ? 0 : 1; },
+		pScratch, leftCount, NULL, rightCount);
+	if (leftCount == 0)
+	{
+		ParallelSplit(scheduler, pPoints, count, [pivot](const point& pt) { return pt.x <= pivot ? 0 : 1; },
+			pScratch, leftCount, NULL, rightCount);
+		if (rightCount == 0)
+		{
+			LeafChains(pPoints, count, chains);
+			return;
+		}
+	}
+
+	HullChains rightChains;
+	TaskGroup group(scheduler);
+	group.Spawn([&]() { DivideAndConquerHull(scheduler, pScratch + leftCount, pPoints + leftCount, rightCount, rightChains); });
+	DivideAndConquerHull(scheduler, pScratch, pPoints, leftCount, chains);
+	group.Wait();
+
+	MergeChains(chains, rightChains);
+}
+
+// **************************************************************************
+// a (at areaA from qp) is farther than b, or as far and further along q - p: of points on a parallel to pq,
+// only the ends are vertices.
+static inline bool IsFarther(const point& p, const point& q, const point& a, double areaA, const point& b, double areaB)
+{
+	return areaA > areaB || (areaA == areaB && (q.x - p.x) * (a.x - b.x) + (q.y - p.y) * (a.y - b.y) > 0);
+}
+
+// **************************************************************************
+// Appends the hull vertices strictly between p and q, from p to q counter clockwise, of points all on the
+// left of q->p.
+static void QuickHullSide(TaskScheduler& scheduler, const point* pPoints, count_t count, point p, point q, std::vector<point>& result)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	// The hull of the points, p and q goes from q straight to p: it is walked from p, up to q
+	if (count <= PARALLEL_HULL_GRAIN_SIZE)
+	{
+		point* pCopy = new point[count + 2];
+		memcpy(pCopy, pPoints, count * sizeof(point));
+		pCopy[count] = p;
+		pCopy[count + 1] = q;
+
+		HullChains chains;
+		LeafChains(pCopy, count + 2, chains);
+		delete[] pCopy;
+
+		// Counter clockwise from the leftmost vertex: lower chain, then upper one backward
+		std::vector<point> hull(chains.lower.begin(), chains.lower.end() - 1);
+		hull.insert(hull.end(), chains.upper.rbegin(), chains.upper.rend() - 1);
+
+		size_t first = 0;
+		while (!compare_points(hull[first], p))
+		{
+			first++;
+		}
+		for (size_t n = (first + 1) % hull.size(); !compare_points(hull[n], q); n = (n + 1) % hull.size())
+		{
+			result.push_back(hull[n]);
+		}
+		return;
+	}
+
+	// Farthest point from pq, a vertex
+	count_t chunkCount = ChunkCount(scheduler, count);
+	std::vector<count_t> farthests(chunkCount);
+	ParallelFor(scheduler, 0, chunkCount, [&](count_t chunk)
+	{
+		count_t farthest = ChunkBegin(count, chunkCount, chunk);
+		double farthestArea = area(q, p, pPoints[farthest]);
+		for (count_t n = farthest + 1; n < ChunkBegin(count, chunkCount, chunk + 1); n++)
+		{
+			double pointArea = area(q, p, pPoints[n]);
+			if (IsFarther(p, q, pPoints[n], pointArea, pPoints[farthest], farthestArea))
+			{
+				farthest = n;
+				farthestArea = pointArea;
+			}
+		}
+		farthests[chunk] = farthest;
+	});
+
+	count_t farthest = farthests[0];
+	for (count_t chunk = 1; chunk < chunkCount; chunk++)
+	{
+		const point& candidate = pPoints[farthests[chunk]];
+		if (IsFarther(p, q, candidate, area(q, p, candidate), pPoints[farthest], area(q, p, pPoints[farthest])))
+		{
+			farthest = farthests[chunk];
+		}
+	}
+	point c = pPoints[farthest];
+
+	// Points outside pc, then outside cq, the others are inside the triangle
+	point* pSides = new point[count];
+	count_t count1, count2;
+	ParallelSplit(scheduler, pPoints, count, [p, q, c](const point& pt) { return left_turn(c, p, pt) ? 0 : (left_turn(q, c, pt) ? 1 : -1); },
+		pSides, count1, NULL, count2);
+
+	std::vector<point> result2;
+	{
+		TaskGroup group(scheduler);
+		group.Spawn([&]() { QuickHullSide(scheduler, pSides + count1, count2, c, q, result2); });
+		QuickHullSide(scheduler, pSides, count1, p, c, result);
+		group.Wait();
+	}
+	delete[] pSides;
+
+	result.push_back(c);
+	result.insert(result.end(), result2.begin(), result2.end());
+}
+
+// **************************************************************************
+// Counter clockwise from the rightmost (then highest) vertex
+static void QuickHull(TaskScheduler& scheduler, const point* pPoints, count_t count, std::vector<point>& hull)
+{
+	hull.clear();
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// Leftmost (then lowest) and rightmost (then highest) points
+	count_t chunkCount = ChunkCount(scheduler, count);
+	std::vector<point> minimums(chunkCount);
+	std::vector<point> maximums(chunkCount);
+	ParallelFor(scheduler, 0, chunkCount, [&](count_t chunk)
+	{
+		count_t begin = ChunkBegin(count, chunkCount, chunk);
+		point minimum = pPoints[begin];
+		point maximum = pPoints[begin];
+		for (count_t n = begin + 1; n < ChunkBegin(count, chunkCount, chunk + 1); n++)
+		{
+			minimum = cmp(pPoints[n], minimum) < 0 ? pPoints[n] : minimum;
+			maximum = cmp(pPoints[n], maximum) > 0 ? pPoints[n] : maximum;
+		}
+		minimums[chunk] = minimum;
+		maximums[chunk] = maximum;
+	});
+
+	point a = minimums[0];
+	point b = maximums[0];
+	for (count_t chunk = 1; chunk < chunkCount; chunk++)
+	{
+		a = cmp(minimums[chunk], a) < 0 ? minimums[chunk] : a;
+		b = cmp(maximums[chunk], b) > 0 ? maximums[chunk] : b;
+	}
+
+	hull.push_back(b);
+	if (compare_points(a, b))
+	{
+		return;
+	}
+
+	// Above ab, then below it
+	point* pSides = new point[count];
+	count_t upperCount, lowerCount;
+	ParallelSplit(scheduler, pPoints, count, [a, b](const point& pt) { return left_turn(a, b, pt) ? 0 : (left_turn(b, a, pt) ? 1 : -1); },
+		pSides, upperCount, NULL, lowerCount);
+
+	std::vector<point> lower;
+	{
+		TaskGroup group(scheduler);
+		group.Spawn([&]() { QuickHullSide(scheduler, pSides + upperCount, lowerCount, a, b, lower); });
+		QuickHullSide(scheduler, pSides, upperCount, b, a, hull);
+		group.Wait();
+	}
+	delete[] pSides;
+
+	hull.push_back(a);
+	hull.insert(hull.end(), lower.begin(), lower.end());
+}
+
+// **************************************************************************
+// Counter clockwise from the rightmost (then highest) vertex
+static void DivideAndConquerHull(TaskScheduler& scheduler, const point* pPoints, count_t count, std::vector<point>& hull)
+{
+	hull.clear();
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// Both buffers are reordered
+	point* pCopy = new point[2 * count];
+	count_t chunkCount = ChunkCount(scheduler, count);
+	ParallelFor(scheduler, 0, chunkCount, [&](count_t chunk)
+	{
+		count_t begin = ChunkBegin(count, chunkCount, chunk);
+		memcpy(pCopy + begin, pPoints + begin, (ChunkBegin(count, chunkCount, chunk + 1) - begin) * sizeof(point));
+	});
+
+	HullChains chains;
+	DivideAndConquerHull(scheduler, pCopy, pCopy + count, count, chains);
+	delete[] pCopy;
+
+	hull.assign(chains.upper.rbegin(), chains.upper.rend());
+	if (chains.lower.size() > 2)
+	{
+		hull.insert(hull.end(), chains.lower.begin() + 1, chains.lower.end() - 1);
+	}
+}
+
+// **************************************************************************
+static point* ToResult(const std::vector<point>& hull, bool closeThePath, int64_t& resultCount)
+{
+	point* results = new point[hull.size() + 1];
+	if (!hull.empty())
+	{
+		memcpy(results, hull.data(), hull.size() * sizeof(point));
+	}
+
+	resultCount = (int64_t)hull.size();
+	if (closeThePath && resultCount > 0)
+	{
+		results[resultCount++] = results[0];
+	}
+
+	return results;
+}
+
+// **************************************************************************
+extern "C" point* parallelQuickHull(point* pPoints, int64_t count, int threadCount, bool closeThePath, int64_t& resultCount)
+{
+	TaskScheduler scheduler(threadCount);
+	std::vector<point> hull;
+	scheduler.Run([&]() { QuickHull(scheduler, pPoints, (count_t)count, hull); });
+	return ToResult(hull, closeThePath, resultCount);
+}
+
+// **************************************************************************
+extern "C" point* parallelDivideAndConquerHull(point* pPoints, int64_t count, int threadCount, bool closeThePath, int64_t& resultCount)
+{
+	TaskScheduler scheduler(threadCount);
+	std::vector<point> hull;
+	scheduler.Run([&]() { DivideAndConquerHull(scheduler, pPoints, (count_t)count, hull); });
+	return ToResult(hull, closeThePath, resultCount);
+}
+
+// **************************************************************************
+extern "C" int parallelHullScaling(int engine, int64_t pointCount, int maxThreadCount, bool isWeakScaling, int* pThreadCounts, double* pSeconds)
+{
+	std::mt19937_64 random(12345);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+	// Points of the biggest run, the others use the beginning
+	maxThreadCount = std::max(maxThreadCount, 1);
+	std::vector<point> points((size_t)(isWeakScaling ? pointCount * maxThreadCount : pointCount));
+	for (auto& pt : points)
+	{
+		pt.x = distribution(random);
+		pt.y = distribution(random);
+	}
+
+	// 1, 2, 4, ... then maxThreadCount, power of 2 or not
+	int entryCount = 0;
+	for (int threadCount = 1; entryCount == 0 || pThreadCounts[entryCount - 1] < maxThreadCount; threadCount = std::min(threadCount * 2, maxThreadCount))
+	{
+		count_t count = (count_t)(isWeakScaling ? pointCount * threadCount : pointCount);
+
+		// The threads are started before timing
+		TaskScheduler scheduler(threadCount);
+		std::vector<point> hull;
+
+		double best = HUGE_VAL;
+		for (int run = 0; run < 3; run++)
+		{
+			double start = omp_get_wtime();
+			scheduler.Run([&]()
+			{
+				if (engine == ParallelHullDivideAndConquer)
+				{
+					DivideAndConquerHull(scheduler, points.data(), count, hull);
+				}
+				else
+				{
+					QuickHull(scheduler, points.data(), count, hull);
+				}
+			});
+			double elapsed = omp_get_wtime() - start;
+			best = elapsed < best ? elapsed : best;
+		}
+
+		pThreadCounts[entryCount] = threadCount;
+		pSeconds[entryCount] = best;
+		entryCount++;
+	}
+
+	return entryCount;
+}
+
+// **************************************************************************
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Point.h"
+
+// Engines of parallelHullScaling
+enum ParallelHullEngine
+{
+	ParallelHullQuick = 0, // parallelQuickHull
+	ParallelHullDivideAndConquer = 1, // parallelDivideAndConquerHull
+};
+
+// Task parallel hulls on a work stealing TaskScheduler of threadCount threads (0: one per core), baselines
+// for the scaling of OuelletHull on many cores. The input is not modified.
+// - Quickhull: the farthest point of each side is a vertex, the points outside the two new sides are the two
+//   subproblems, each one a task. Searches and splits of big subproblems are done by chunks on all threads.
+// - Divide and conquer: points are split by x at the median of a sample (in parallel by chunks), both halves
+//   are tasks, small ones are sorted and done with a monotone chain. Two hulls split by x are merged from
+//   their lower and upper tangents, O(h).
+// The result has the layout of mergeHulls: counter clockwise, starting at the rightmost (then highest) vertex,
+// closed if asked. Free with delete[].
+extern "C"
+{
+	point* parallelQuickHull(point* pPoints, int64_t count, int threadCount, bool closeThePath, int64_t& resultCount);
+	point* parallelDivideAndConquerHull(point* pPoints, int64_t count, int threadCount, bool closeThePath, int64_t& resultCount);
+
+	// Scaling curve of an engine (ParallelHullEngine) on random points in a square, for 1, 2, 4, ...
+	// maxThreadCount threads. Strong scaling: pointCount points whatever the thread count. Weak scaling:
+	// pointCount points per thread. pThreadCounts and pSeconds (best of 3 runs) need room for
+	// log2(maxThreadCount) + 2 entries. Returns the count of entries.
+	int parallelHullScaling(int engine, int64_t pointCount, int maxThreadCount, bool isWeakScaling, int* pThreadCounts, double* pSeconds);
+}
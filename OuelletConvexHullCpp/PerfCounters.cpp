@@ -0,0 +1,155 @@
+#include "Stdafx.h"
+#include "PerfCounters.h"
+#include <string.h>
+#include <omp.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#pragma managed(push, off)
+
+#ifdef __linux__
+// **************************************************************************
+// -1 when the counter can't be opened
+static int OpenCounter(uint32_t type, uint64_t config)
+{
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.inherit = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+// **************************************************************************
+PerfCounters::PerfCounters(bool isEnabled)
+{
+	for (int counter = 0; counter < PerfCounterCount; counter++)
+	{
+		_fds[counter] = -1;
+	}
+
+#ifdef __linux__
+	if (!isEnabled)
+	{
+		return;
+	}
+
+	_fds[PerfCycles] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	_fds[PerfInstructions] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	_fds[PerfBranchMisses] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+	_fds[PerfL1DataMisses] = OpenCounter(PERF_TYPE_HW_CACHE,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+	_fds[PerfLastLevelCacheMisses] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+}
+
+// **************************************************************************
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+	for (int counter = 0; counter < PerfCounterCount; counter++)
+	{
+		if (_fds[counter] >= 0)
+		{
+			close(_fds[counter]);
+		}
+	}
+#endif
+}
+
+// **************************************************************************
+bool PerfCounters::IsAvailable(int counter) const
+{
+	return _fds[counter] >= 0;
+}
+
+// **************************************************************************
+bool PerfCounters::IsAnyAvailable() const
+{
+	for (int counter = 0; counter < PerfCounterCount; counter++)
+	{
+		if (IsAvailable(counter))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// **************************************************************************
+void PerfCounters::Read(uint64_t* pValues) const
+{
+	for (int counter = 0; counter < PerfCounterCount; counter++)
+	{
+		pValues[counter] = 0;
+
+#ifdef __linux__
+		// Count, time enabled, time counting
+		uint64_t values[3];
+		if (_fds[counter] >= 0 && read(_fds[counter], values, sizeof(values)) == sizeof(values) && values[2] > 0)
+		{
+			pValues[counter] = values[2] < values[1] ? (uint64_t)((double)values[0] * values[1] / values[2]) : values[0];
+		}
+#endif
+	}
+}
+
+// **************************************************************************
+PerfPhaseCounters::PerfPhaseCounters(int phaseCount, bool useCounters) : _counters(useCounters)
+{
+	_phaseCount = phaseCount;
+	_phase = -1;
+	_pValues = new uint64_t[phaseCount * PerfCounterCount];
+	memset(_pValues, 0, phaseCount * PerfCounterCount * sizeof(uint64_t));
+	memset(_lastValues, 0, sizeof(_lastValues));
+	_lastTime = 0;
+	_pSeconds = new double[phaseCount];
+	memset(_pSeconds, 0, phaseCount * sizeof(double));
+}
+
+// **************************************************************************
+PerfPhaseCounters::~PerfPhaseCounters()
+{
+	delete[] _pValues;
+	delete[] _pSeconds;
+}
+
+// **************************************************************************
+void PerfPhaseCounters::Enter(int phase)
+{
+	uint64_t values[PerfCounterCount];
+	_counters.Read(values);
+	double time = omp_get_wtime();
+
+	if (_phase >= 0)
+	{
+		_pSeconds[_phase] += time - _lastTime;
+
+		uint64_t* pPhaseValues = _pValues + _phase * PerfCounterCount;
+		for (int counter = 0; counter < PerfCounterCount; counter++)
+		{
+			// Scaled counts of a multiplexed counter can step back a little
+			if (values[counter] > _lastValues[counter])
+			{
+				pPhaseValues[counter] += values[counter] - _lastValues[counter];
+			}
+		}
+	}
+
+	memcpy(_lastValues, values, sizeof(values));
+	_lastTime = time;
+	_phase = phase;
+}
+
+#pragma managed(pop)
+
+// **************************************************************************
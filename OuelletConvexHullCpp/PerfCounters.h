@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+// Hardware counters of PerfCounters
+enum PerfCounter
+{
+	PerfCycles = 0,
+	PerfInstructions = 1,
+	PerfBranchMisses = 2,
+	PerfL1DataMisses = 3, // Read misses of the L1 data cache
+	PerfLastLevelCacheMisses = 4,
+	PerfCounterCount = 5,
+};
+
+// Linux perf_event counters of the calling thread and of the threads it starts while they are open (inherit),
+// user space only (what perf_event_paranoid 2 allows). Counters the kernel or the CPU don't give (other
+// systems, most virtual machines and containers) are not available: they read 0, the others still count.
+// When the PMU has to multiplex them, counts are scaled by the part of the time they actually counted.
+class PerfCounters
+{
+private:
+	int _fds[PerfCounterCount];
+
+public:
+	// isEnabled false: no counter is opened, all are not available
+	PerfCounters(bool isEnabled = true);
+	~PerfCounters();
+
+	bool IsAvailable(int counter) const;
+	bool IsAnyAvailable() const;
+
+	// PerfCounterCount values, counted since the counters were opened
+	void Read(uint64_t* pValues) const;
+};
+
+// PerfCounters and wall time split by phase: Enter charges what was counted since the previous Enter to the
+// phase then current. Every Enter reads the counters (a system call each): phases must be much longer than
+// that, or the counters not used.
+class PerfPhaseCounters
+{
+private:
+	PerfCounters _counters;
+	int _phaseCount;
+	int _phase; // -1: none, nothing is charged
+	uint64_t _lastValues[PerfCounterCount];
+	double _lastTime;
+	uint64_t* _pValues; // PerfCounterCount by phase
+	double* _pSeconds; // By phase
+
+public:
+	PerfPhaseCounters(int phaseCount, bool useCounters = true);
+	~PerfPhaseCounters();
+
+	const PerfCounters& Counters() const { return _counters; }
+
+	// phase -1: out of any phase
+	void Enter(int phase);
+
+	// PerfCounterCount values charged to the phase
+	const uint64_t* Values(int phase) const { return _pValues + phase * PerfCounterCount; }
+	double Seconds(int phase) const { return _pSeconds[phase]; }
+};
@@ -0,0 +1,200 @@
+#include "TaskScheduler.h"
+
+// Scheduler and worker of the current thread
+static thread_local TaskScheduler* _pCurrentScheduler = NULL;
+static thread_local int _currentWorker = 0;
+
+// **************************************************************************
+TaskScheduler::TaskScheduler(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency();
+		threadCount = threadCount > 0 ? threadCount : 1;
+	}
+
+	_isRunning = false;
+	_isStopping = false;
+	for (int n = 0; n < threadCount; n++)
+	{
+		_workers.push_back(new Worker());
+		_workers[n]->random = 0x9E3779B97F4A7C15ull * (n + 1);
+	}
+
+	for (int n = 1; n < threadCount; n++)
+	{
+		_threads.push_back(std::thread(&TaskScheduler::WorkerLoop, this, n));
+	}
+}
+
+// **************************************************************************
+TaskScheduler::~TaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> guard(_idleLock);
+		_isStopping = true;
+	}
+	_idle.notify_all();
+
+	for (auto& thread : _threads)
+	{
+		thread.join();
+	}
+
+	for (Worker* pWorker : _workers)
+	{
+		delete pWorker;
+	}
+}
+
+// **************************************************************************
+int TaskScheduler::ThreadCount() const
+{
+	return (int)_workers.size();
+}
+
+// **************************************************************************
+// Threads not in the pool (outside of Run) push on the deque of the calling thread of Run
+int TaskScheduler::CurrentWorker() const
+{
+	return _pCurrentScheduler == this ? _currentWorker : 0;
+}
+
+// **************************************************************************
+void TaskScheduler::Push(std::function<void()>&& task)
+{
+	Worker* pWorker = _workers[CurrentWorker()];
+	std::lock_guard<std::mutex> guard(pWorker->lock);
+	pWorker->tasks.push_back(std::move(task));
+}
+
+// **************************************************************************
+bool TaskScheduler::RunOne(int workerIndex)
+{
+	std::function<void()> task;
+
+	Worker* pWorker = _workers[workerIndex];
+	{
+		std::lock_guard<std::mutex> guard(pWorker->lock);
+		if (!pWorker->tasks.empty())
+		{
+			task = std::move(pWorker->tasks.back());
+			pWorker->tasks.pop_back();
+		}
+	}
+
+	int workerCount = (int)_workers.size();
+	if (!task && workerCount > 1)
+	{
+		// Xorshift, then every other worker from a random one
+		uint64_t& random = pWorker->random;
+		random ^= random << 13;
+		random ^= random >> 7;
+		random ^= random << 17;
+
+		int first = (int)(random % (uint64_t)(workerCount - 1));
+		for (int n = 0; n < workerCount - 1 && !task; n++)
+		{
+			int victim = (workerIndex + 1 + (first + n) % (workerCount - 1)) % workerCount;
+			Worker* pVictim = _workers[victim];
+			std::lock_guard<std::mutex> guard(pVictim->lock);
+			if (!pVictim->tasks.empty())
+			{
+				task = std::move(pVictim->tasks.front());
+				pVictim->tasks.pop_front();
+			}
+		}
+	}
+
+	if (!task)
+	{
+		return false;
+	}
+
+	task();
+	return true;
+}
+
+// **************************************************************************
+void TaskScheduler::WorkerLoop(int workerIndex)
+{
+	_pCurrentScheduler = this;
+	_currentWorker = workerIndex;
+
+	while (!_isStopping)
+	{
+		if (RunOne(workerIndex))
+		{
+			continue;
+		}
+
+		if (_isRunning)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Nothing to do until the next Run
+		std::unique_lock<std::mutex> guard(_idleLock);
+		_idle.wait(guard, [this] { return _isRunning || _isStopping; });
+	}
+}
+
+// **************************************************************************
+void TaskScheduler::Run(const std::function<void()>& root)
+{
+	TaskScheduler* pPreviousScheduler = _pCurrentScheduler;
+	int previousWorker = _currentWorker;
+	_pCurrentScheduler = this;
+	_currentWorker = 0;
+
+	{
+		std::lock_guard<std::mutex> guard(_idleLock);
+		_isRunning = true;
+	}
+	_idle.notify_all();
+
+	root();
+
+	_isRunning = false;
+	_pCurrentScheduler = pPreviousScheduler;
+	_currentWorker = previousWorker;
+}
+
+// **************************************************************************
+TaskGroup::TaskGroup(TaskScheduler& scheduler) : _scheduler(scheduler)
+{
+	_pendingCount = 0;
+}
+
+// **************************************************************************
+TaskGroup::~TaskGroup()
+{
+	Wait();
+}
+
+// **************************************************************************
+void TaskGroup::Spawn(std::function<void()> task)
+{
+	_pendingCount++;
+	_scheduler.Push([this, task]()
+	{
+		task();
+		_pendingCount--; // Last use of the group, it can be gone right after
+	});
+}
+
+// **************************************************************************
+void TaskGroup::Wait()
+{
+	int workerIndex = _scheduler.CurrentWorker();
+	while (_pendingCount > 0)
+	{
+		if (!_scheduler.RunOne(workerIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// **************************************************************************
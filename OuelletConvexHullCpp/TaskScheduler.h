@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork join on a pool of threads with work stealing, for the task parallel hulls (OpenMP 2.0 of the toolset
+// has no tasks). Every thread has its own deque: tasks it spawns are pushed and popped at the back (depth
+// first, cache friendly), idle threads steal at the front of a random other deque (the oldest, biggest tasks).
+// A thread waiting on a TaskGroup runs tasks meanwhile, so nested fork join never blocks a thread.
+//
+// Uses std::thread: files including it must be compiled without /clr.
+class TaskScheduler
+{
+	friend class TaskGroup;
+
+private:
+	struct Worker
+	{
+		std::mutex lock;
+		std::deque<std::function<void()>> tasks;
+		uint64_t random; // Victim choice
+	};
+
+	std::vector<Worker*> _workers; // 0 is the thread calling Run
+	std::vector<std::thread> _threads;
+	std::atomic<bool> _isRunning;
+	std::atomic<bool> _isStopping;
+	std::mutex _idleLock;
+	std::condition_variable _idle;
+
+	int CurrentWorker() const;
+	void Push(std::function<void()>&& task);
+	bool RunOne(int workerIndex); // Own task or a stolen one, false if none was found
+	void WorkerLoop(int workerIndex);
+
+public:
+	TaskScheduler(int threadCount = 0); // 0: one thread per core
+	~TaskScheduler();
+
+	int ThreadCount() const;
+	void Run(const std::function<void()>& root); // Root runs on the calling thread, its tasks on all threads
+};
+
+// Tasks spawned together and waited together
+class TaskGroup
+{
+private:
+	TaskScheduler& _scheduler;
+	std::atomic<int64_t> _pendingCount;
+
+public:
+	TaskGroup(TaskScheduler& scheduler);
+	~TaskGroup(); // Waits
+
+	void Spawn(std::function<void()> task);
+	void Wait();
+};
@@ -1,27 +1,41 @@
 #pragma once
 
 #include <stdio.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
 #include "Node.h"
 
 // source: https://rosettacode.org/wiki/AVL_tree#C.2B.2B
+// Changed from the source: node heights are cached (rebalance was O(n)), deleteKey is rewritten (it was
+// leaking and could unlink the wrong node), keys are only compared with TLess and in-order navigation is added.
+// Definitions are in this header because the class is a template.
 
 /* AVL tree */
-template <class T>
-class AvlTree 
+template <class T, class TLess = std::less<T> >
+class AvlTree
 {
 public:
 	AvlTree(void);
-	~AvlTree(void);
+	virtual ~AvlTree(void);
 	virtual bool insert(const T key);
-	void deleteKey(const T key);
+	bool deleteKey(const T key);
+	void clear();
 	void printBalance();
 
 public:
-	//AvlNode<T> GetNextNode(AvlNode<T>* avlNode);
-	//AvlNode<T> GetPreviousNode(AvlNode<T>* avlNode);
+	AvlNode<T>* findNode(const T& key) const;
+	AvlNode<T>* lowerNode(const T& key) const; // Greatest key strictly less than key
+	AvlNode<T>* higherNode(const T& key) const; // Smallest key strictly greater than key
+	AvlNode<T>* firstNode() const;
+	AvlNode<T>* lastNode() const;
+	static AvlNode<T>* nextNode(AvlNode<T>* n);
+	static AvlNode<T>* previousNode(AvlNode<T>* n);
 
 protected:
 	AvlNode<T> *root;
+	TLess less;
+	bool equals(const T& a, const T& b) const { return !less(a, b) && !less(b, a); }
 	AvlNode<T>* rotateLeft(AvlNode<T> *a);
 	AvlNode<T>* rotateRight(AvlNode<T> *a);
 	AvlNode<T>* rotateLeftThenRight(AvlNode<T> *n);
@@ -30,6 +44,354 @@ protected:
 	int height(AvlNode<T> *n);
 	void setBalance(AvlNode<T> *n);
 	void printBalance(AvlNode<T> *n);
-	void clearNode(AvlNode<T> *n);
 };
 
+/* AVL class definition */
+
+// **************************************************************************
+template <class T, class TLess>
+void AvlTree<T, TLess>::rebalance(AvlNode<T> *n)
+{
+	setBalance(n);
+
+	if (n->balance == -2) {
+		if (height(n->left->left) >= height(n->left->right))
+			n = rotateRight(n);
+		else
+			n = rotateLeftThenRight(n);
+	}
+	else if (n->balance == 2) {
+		if (height(n->right->right) >= height(n->right->left))
+			n = rotateLeft(n);
+		else
+			n = rotateRightThenLeft(n);
+	}
+
+	if (n->parent != NULL) {
+		rebalance(n->parent);
+	}
+	else {
+		root = n;
+	}
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::rotateLeft(AvlNode<T> *a)
+{
+	AvlNode<T> *b = a->right;
+	b->parent = a->parent;
+	a->right = b->left;
+
+	if (a->right != NULL)
+		a->right->parent = a;
+
+	b->left = a;
+	a->parent = b;
+
+	if (b->parent != NULL) {
+		if (b->parent->right == a) {
+			b->parent->right = b;
+		}
+		else {
+			b->parent->left = b;
+		}
+	}
+
+	setBalance(a);
+	setBalance(b);
+	return b;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::rotateRight(AvlNode<T> *a)
+{
+	AvlNode<T> *b = a->left;
+	b->parent = a->parent;
+	a->left = b->right;
+
+	if (a->left != NULL)
+		a->left->parent = a;
+
+	b->right = a;
+	a->parent = b;
+
+	if (b->parent != NULL) {
+		if (b->parent->right == a) {
+			b->parent->right = b;
+		}
+		else {
+			b->parent->left = b;
+		}
+	}
+
+	setBalance(a);
+	setBalance(b);
+	return b;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::rotateLeftThenRight(AvlNode<T> *n)
+{
+	n->left = rotateLeft(n->left);
+	return rotateRight(n);
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::rotateRightThenLeft(AvlNode<T> *n)
+{
+	n->right = rotateRight(n->right);
+	return rotateLeft(n);
+}
+
+// **************************************************************************
+template <class T, class TLess>
+int AvlTree<T, TLess>::height(AvlNode<T> *n)
+{
+	if (n == NULL)
+		return -1;
+	return n->height;
+}
+
+// **************************************************************************
+// Children must be up to date
+template <class T, class TLess>
+void AvlTree<T, TLess>::setBalance(AvlNode<T> *n)
+{
+	n->height = 1 + std::max(height(n->left), height(n->right));
+	n->balance = height(n->right) - height(n->left);
+}
+
+// **************************************************************************
+template <class T, class TLess>
+void AvlTree<T, TLess>::printBalance(AvlNode<T> *n)
+{
+	if (n != NULL) {
+		printBalance(n->left);
+		std::cout << n->balance << " ";
+		printBalance(n->right);
+	}
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlTree<T, TLess>::AvlTree(void) : root(NULL)
+{
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlTree<T, TLess>::~AvlTree(void)
+{
+	delete root;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+void AvlTree<T, TLess>::clear()
+{
+	delete root;
+	root = NULL;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+bool AvlTree<T, TLess>::insert(T key)
+{
+	if (root == NULL) {
+		root = new AvlNode<T>(key, NULL);
+	}
+	else {
+		AvlNode<T>
+			*n = root,
+			*parent;
+
+		while (true) {
+			if (equals(n->key, key))
+				return false;
+
+			parent = n;
+
+			bool goLeft = less(key, n->key);
+			n = goLeft ? n->left : n->right;
+
+			if (n == NULL) {
+				if (goLeft) {
+					parent->left = new AvlNode<T>(key, parent);
+				}
+				else {
+					parent->right = new AvlNode<T>(key, parent);
+				}
+
+				rebalance(parent);
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+bool AvlTree<T, TLess>::deleteKey(const T delKey)
+{
+	AvlNode<T>* n = findNode(delKey);
+	if (n == NULL)
+		return false;
+
+	if (n->left != NULL && n->right != NULL) {
+		// Take the key of the in-order successor (it has no left child) and remove the successor instead
+		AvlNode<T>* successor = n->right;
+		while (successor->left != NULL)
+			successor = successor->left;
+
+		n->key = successor->key;
+		n = successor;
+	}
+
+	AvlNode<T>
+		*child = n->left != NULL ? n->left : n->right,
+		*parent = n->parent;
+
+	if (child != NULL)
+		child->parent = parent;
+
+	if (parent == NULL) {
+		root = child;
+	}
+	else if (parent->left == n) {
+		parent->left = child;
+	}
+	else {
+		parent->right = child;
+	}
+
+	n->left = NULL; // Otherwise the node destructor deletes the moved subtree
+	n->right = NULL;
+	delete n;
+
+	if (parent != NULL)
+		rebalance(parent);
+
+	return true;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::findNode(const T& key) const
+{
+	AvlNode<T>* n = root;
+	while (n != NULL) {
+		if (less(key, n->key))
+			n = n->left;
+		else if (less(n->key, key))
+			n = n->right;
+		else
+			return n;
+	}
+	return NULL;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::lowerNode(const T& key) const
+{
+	AvlNode<T> *n = root, *result = NULL;
+	while (n != NULL) {
+		if (less(n->key, key)) {
+			result = n;
+			n = n->right;
+		}
+		else {
+			n = n->left;
+		}
+	}
+	return result;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::higherNode(const T& key) const
+{
+	AvlNode<T> *n = root, *result = NULL;
+	while (n != NULL) {
+		if (less(key, n->key)) {
+			result = n;
+			n = n->left;
+		}
+		else {
+			n = n->right;
+		}
+	}
+	return result;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::firstNode() const
+{
+	AvlNode<T>* n = root;
+	if (n != NULL) {
+		while (n->left != NULL)
+			n = n->left;
+	}
+	return n;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::lastNode() const
+{
+	AvlNode<T>* n = root;
+	if (n != NULL) {
+		while (n->right != NULL)
+			n = n->right;
+	}
+	return n;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::nextNode(AvlNode<T>* n)
+{
+	if (n->right != NULL) {
+		n = n->right;
+		while (n->left != NULL)
+			n = n->left;
+		return n;
+	}
+
+	while (n->parent != NULL && n->parent->right == n)
+		n = n->parent;
+	return n->parent;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+AvlNode<T>* AvlTree<T, TLess>::previousNode(AvlNode<T>* n)
+{
+	if (n->left != NULL) {
+		n = n->left;
+		while (n->right != NULL)
+			n = n->right;
+		return n;
+	}
+
+	while (n->parent != NULL && n->parent->left == n)
+		n = n->parent;
+	return n->parent;
+}
+
+// **************************************************************************
+template <class T, class TLess>
+void AvlTree<T, TLess>::printBalance()
+{
+	printBalance(root);
+	std::cout << std::endl;
+}
+
+// **************************************************************************
@@ -3,7 +3,13 @@
 #include "Point.h"
 #include "AvlTree.h"
 
-class AvlTreeHull : public AvlTree<point>
+// Lexicographic order (x then y), same as the cmp macro
+struct PointLexLess
+{
+	bool operator()(const point& a, const point& b) const { return cmp(a, b) < 0; }
+};
+
+class AvlTreeHull : public AvlTree<point, PointLexLess>
 {
 public:
 	bool insert(const point key) override;
@@ -0,0 +1,114 @@
+#include "Stdafx.h"
+#include "ConvexLayers.h"
+#include <vector>
+#include <algorithm>
+
+// **************************************************************************
+static inline bool IsLexLess(const point& a, const point& b)
+{
+	return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// **************************************************************************
+ConvexLayers::ConvexLayers(const point* pPoints, int64_t count)
+{
+	_hull.Build(pPoints, count);
+}
+
+// **************************************************************************
+ConvexLayers::~ConvexLayers()
+{
+}
+
+// **************************************************************************
+point* ConvexLayers::NextLayer(int64_t& count, bool closeThePath)
+{
+	point* results = _hull.GetResultAsArray(count, closeThePath);
+	if (results == NULL)
+	{
+		return NULL;
+	}
+
+	int64_t vertexCount = (closeThePath && count > 1) ? count - 1 : count;
+	for (int64_t n = 0; n < vertexCount; n++)
+	{
+		while (_hull.Remove(results[n]))
+		{
+		}
+	}
+
+	_layerCount++;
+	return results;
+}
+
+// **************************************************************************
+int64_t ConvexLayers::LayerCount() const
+{
+	return _layerCount;
+}
+
+// **************************************************************************
+int64_t ConvexLayers::Count() const
+{
+	return _hull.Count();
+}
+
+// **************************************************************************
+extern "C" int64_t convexLayerDepths(point* pPoints, int64_t count, int64_t maxLayerCount, int64_t* pDepths)
+{
+	// Indexes in point order: all the copies of a vertex are found at once
+	std::vector<int64_t> indexes((size_t)count);
+	for (int64_t n = 0; n < count; n++)
+	{
+		indexes[(size_t)n] = n;
+		pDepths[n] = -1;
+	}
+	std::sort(indexes.begin(), indexes.end(), [pPoints](int64_t a, int64_t b) { return IsLexLess(pPoints[a], pPoints[b]); });
+
+	ConvexLayers layers(pPoints, count);
+	while (maxLayerCount <= 0 || layers.LayerCount() < maxLayerCount)
+	{
+		int64_t depth = layers.LayerCount();
+		int64_t hullCount;
+		point* pHull = layers.NextLayer(hullCount, false);
+		if (pHull == NULL)
+		{
+			break;
+		}
+
+		for (int64_t n = 0; n < hullCount; n++)
+		{
+			const point& pt = pHull[n];
+			auto it = std::lower_bound(indexes.begin(), indexes.end(), pt,
+				[pPoints](int64_t index, const point& value) { return IsLexLess(pPoints[index], value); });
+			for (; it != indexes.end() && compare_points(pPoints[*it], pt); ++it)
+			{
+				pDepths[*it] = depth;
+			}
+		}
+
+		delete[] pHull;
+	}
+
+	return layers.LayerCount();
+}
+
+// **************************************************************************
+extern "C" ConvexLayers* convexLayersCreate(point* pPoints, int64_t count)
+{
+	return new ConvexLayers(pPoints, count);
+}
+
+// **************************************************************************
+extern "C" point* convexLayersNext(ConvexLayers* pLayers, bool closeThePath, int64_t& resultCount)
+{
+	return pLayers->NextLayer(resultCount, closeThePath);
+}
+
+// **************************************************************************
+extern "C" void convexLayersDelete(ConvexLayers* pLayers)
+{
+	delete pLayers;
+}
+
+// **************************************************************************
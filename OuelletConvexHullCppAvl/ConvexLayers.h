@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Point.h"
+#include "DynamicHull.h"
+
+// Convex layers (onion peeling): layer 0 is the hull of the points, layer 1 the hull of what is left
+// once layer 0 is removed, and so on. A layer has the same vertices as OuelletHull would give on the
+// remaining points: points in the middle of an edge go to the next layer, copies of a vertex go with it.
+//
+// All the points go in a DynamicHull (built at once, O(n log n)), each layer is read from it then deleted
+// from it: every point is removed once, O(n log^2 n) overall instead of O(n) per layer when the hull is redone.
+class ConvexLayers
+{
+private:
+	DynamicHull _hull;
+	int64_t _layerCount = 0;
+
+public:
+	ConvexLayers(const point* pPoints, int64_t count);
+	~ConvexLayers();
+
+	point* NextLayer(int64_t& count, bool closeThePath = true); // Peel the current hull, NULL when no point is left. Free with delete[].
+	int64_t LayerCount() const; // Layers peeled so far
+	int64_t Count() const; // Points not peeled yet
+};
+
+extern "C"
+{
+	// Depth (layer index) of every point, -1 for points deeper than maxLayerCount layers (0: no limit).
+	// Returns the count of layers peeled.
+	int64_t convexLayerDepths(point* pPoints, int64_t count, int64_t maxLayerCount, int64_t* pDepths);
+
+	ConvexLayers* convexLayersCreate(point* pPoints, int64_t count);
+	point* convexLayersNext(ConvexLayers* pLayers, bool closeThePath, int64_t& resultCount);
+	void convexLayersDelete(ConvexLayers* pLayers);
+}
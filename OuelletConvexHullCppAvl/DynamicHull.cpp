@@ -0,0 +1,714 @@
+#include "Stdafx.h"
+#include "DynamicHull.h"
+#include "SortedHull.h"
+#include <algorithm>
+#include <random>
+#include <math.h>
+#include <omp.h>
+
+// The lower hull of the points is the upper hull of the points turned by 180 degrees (dir = -1).
+// Turned, the lexicographic order is reversed: the left subtree becomes the right one and
+// the lower bridge (lowerLeft, lowerRight) is read as (lowerRight, lowerLeft).
+
+#define NODE_BLOCK_SIZE 4096
+
+// **************************************************************************
+static inline bool IsLexLess(const point& a, const point& b)
+{
+	return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// **************************************************************************
+static inline point Turn(const point& pt, int dir)
+{
+	point result = { dir * pt.x, dir * pt.y };
+	return result;
+}
+
+// **************************************************************************
+static inline DynamicHullNode* First(const DynamicHullNode* node, int dir)
+{
+	return dir > 0 ? node->left : node->right;
+}
+
+// **************************************************************************
+static inline DynamicHullNode* Second(const DynamicHullNode* node, int dir)
+{
+	return dir > 0 ? node->right : node->left;
+}
+
+// **************************************************************************
+// Upper hull bridge of the (turned) subtree, a is in First, b in Second. A leaf is its own bridge.
+static inline void GetBridge(const DynamicHullNode* node, int dir, point& a, point& b)
+{
+	if (node->left == NULL)
+	{
+		a = b = Turn(node->minPt, dir);
+	}
+	else if (dir > 0)
+	{
+		a = node->upperLeft;
+		b = node->upperRight;
+	}
+	else
+	{
+		a = Turn(node->lowerRight, dir);
+		b = Turn(node->lowerLeft, dir);
+	}
+}
+
+// **************************************************************************
+DynamicHull::DynamicHull()
+{
+}
+
+// **************************************************************************
+DynamicHull::~DynamicHull()
+{
+	Clear();
+}
+
+// **************************************************************************
+void DynamicHull::Clear()
+{
+	for (DynamicHullNode* pBlock : _nodeBlocks)
+	{
+		delete[] pBlock;
+	}
+	_nodeBlocks.clear();
+	_freeNodes = NULL;
+	_root = NULL;
+	_count = 0;
+}
+
+// **************************************************************************
+DynamicHullNode* DynamicHull::NewNode()
+{
+	if (_freeNodes == NULL)
+	{
+		DynamicHullNode* pBlock = new DynamicHullNode[NODE_BLOCK_SIZE];
+		_nodeBlocks.push_back(pBlock);
+		for (int n = 0; n < NODE_BLOCK_SIZE; n++)
+		{
+			FreeNode(&pBlock[n]);
+		}
+	}
+
+	DynamicHullNode* node = _freeNodes;
+	_freeNodes = node->left;
+	return node;
+}
+
+// **************************************************************************
+DynamicHullNode* DynamicHull::NewLeaf(const point& pt)
+{
+	DynamicHullNode* node = NewNode();
+	node->left = NULL;
+	node->right = NULL;
+	node->minPt = pt;
+	node->copyCount = 1;
+	node->height = 0;
+	return node;
+}
+
+// **************************************************************************
+void DynamicHull::FreeNode(DynamicHullNode* node)
+{
+	node->left = _freeNodes;
+	_freeNodes = node;
+}
+
+// **************************************************************************
+// Bridge of the upper hull of the turned points of node: first is a point of First(node), second of Second(node).
+//
+// x and y always hold the bridge ends (p in x, q in y). With (a, b) the bridge of x and (c, d) the bridge of y:
+// - c above the line ab: p can't be right of a (every point right of the hull of x and above one of its edges
+//   sees it from the left of that edge).
+// - b above the line cd: q can't be left of d (same, mirrored).
+// - x is a leaf (p = b) under the line cd: q can't be right of c.
+// - y is a leaf (q = c) under the line ab: p can't be left of b.
+// - Otherwise, lines ab and cd cross between b and c. When they cross left of the separator (any x between
+//   both sets), every point of y is under the line ab, so p can't be left of b. Otherwise every point of x
+//   is under the line cd, so q can't be right of c.
+void DynamicHull::FindBridge(const DynamicHullNode* node, int dir, point& first, point& second)
+{
+	const DynamicHullNode* x = First(node, dir);
+	const DynamicHullNode* y = Second(node, dir);
+	double separatorX = dir * node->right->minPt.x;
+
+	point a, b, c, d;
+	while (x->left != NULL || y->left != NULL)
+	{
+		GetBridge(x, dir, a, b);
+		GetBridge(y, dir, c, d);
+
+		if (x->left != NULL && area(a, b, c) > 0)
+		{
+			x = First(x, dir);
+		}
+		else if (y->left != NULL && area(c, d, b) > 0)
+		{
+			y = Second(y, dir);
+		}
+		else if (x->left == NULL)
+		{
+			y = First(y, dir);
+		}
+		else if (y->left == NULL)
+		{
+			x = Second(x, dir);
+		}
+		else if (a.x == b.x) // Vertical edge, only at the left end of a hull: the bridge can't start under it
+		{
+			x = Second(x, dir);
+		}
+		else if (c.x == d.x)
+		{
+			y = Second(y, dir);
+		}
+		else
+		{
+			double yAb = a.y + (b.y - a.y) * (separatorX - a.x) / (b.x - a.x);
+			double yCd = c.y + (d.y - c.y) * (separatorX - c.x) / (d.x - c.x);
+			if (yAb >= yCd)
+			{
+				x = Second(x, dir);
+			}
+			else
+			{
+				y = First(y, dir);
+			}
+		}
+	}
+
+	first = x->minPt;
+	second = y->minPt;
+}
+
+// **************************************************************************
+void DynamicHull::Update(DynamicHullNode* node)
+{
+	node->height = 1 + std::max(node->left->height, node->right->height);
+	node->minPt = node->left->minPt;
+	FindBridge(node, 1, node->upperLeft, node->upperRight);
+	FindBridge(node, -1, node->lowerRight, node->lowerLeft);
+}
+
+// **************************************************************************
+DynamicHullNode* DynamicHull::RotateLeft(DynamicHullNode* node)
+{
+	DynamicHullNode* right = node->right;
+	node->right = right->left;
+	right->left = node;
+	Update(node);
+	Update(right);
+	return right;
+}
+
+// **************************************************************************
+DynamicHullNode* DynamicHull::RotateRight(DynamicHullNode* node)
+{
+	DynamicHullNode* left = node->left;
+	node->left = left->right;
+	left->right = node;
+	Update(node);
+	Update(left);
+	return left;
+}
+
+// **************************************************************************
+// Is pt, from the left (isLeft) or right subtree of node, on the hull of node? It is when it is on the hull of
+// its subtree and on the side of the bridge end that belongs to that subtree.
+bool DynamicHull::IsOnHull(const DynamicHullNode* node, int dir, bool isLeft, const point& pt)
+{
+	if (isLeft)
+	{
+		return !IsLexLess(dir > 0 ? node->upperLeft : node->lowerLeft, pt);
+	}
+
+	return !IsLexLess(pt, dir > 0 ? node->upperRight : node->lowerRight);
+}
+
+// **************************************************************************
+// The bridge is only searched again when the hull of the changed child changed. Then the hull of node changed
+// when pt is (insert) or was (remove) one of its vertices, or when the bridge moved.
+void DynamicHull::RefreshBridge(DynamicHullNode* node, int dir, bool isLeft, const Change& change, bool& isHullChanged)
+{
+	if (!isHullChanged)
+	{
+		return;
+	}
+
+	if (!change.isInsert && !IsOnHull(node, dir, isLeft, change.pt))
+	{
+		isHullChanged = false;
+		return;
+	}
+
+	point& left = dir > 0 ? node->upperLeft : node->lowerLeft;
+	point& right = dir > 0 ? node->upperRight : node->lowerRight;
+	point previousLeft = left;
+	point previousRight = right;
+
+	if (dir > 0)
+	{
+		FindBridge(node, dir, left, right);
+	}
+	else
+	{
+		FindBridge(node, dir, right, left);
+	}
+
+	if (change.isInsert)
+	{
+		isHullChanged = IsOnHull(node, dir, isLeft, change.pt) || !compare_points(left, previousLeft) || !compare_points(right, previousRight);
+	}
+}
+
+// **************************************************************************
+// Children must be up to date. A rotation keeps the points of the subtree, so its hull changed as before.
+DynamicHullNode* DynamicHull::Rebalance(DynamicHullNode* node, bool isLeft, Change& change)
+{
+	int balance = node->right->height - node->left->height;
+
+	if (balance > 1)
+	{
+		if (node->right->left->height > node->right->right->height)
+		{
+			node->right = RotateRight(node->right);
+		}
+		return RotateLeft(node);
+	}
+
+	if (balance < -1)
+	{
+		if (node->left->right->height > node->left->left->height)
+		{
+			node->left = RotateLeft(node->left);
+		}
+		return RotateRight(node);
+	}
+
+	node->height = 1 + std::max(node->left->height, node->right->height);
+	node->minPt = node->left->minPt;
+	RefreshBridge(node, 1, isLeft, change, change.isUpperChanged);
+	RefreshBridge(node, -1, isLeft, change, change.isLowerChanged);
+	return node;
+}
+
+// **************************************************************************
+DynamicHullNode* DynamicHull::Insert(DynamicHullNode* node, Change& change)
+{
+	if (node->left == NULL)
+	{
+		if (compare_points(node->minPt, change.pt))
+		{
+			node->copyCount++;
+			return node;
+		}
+
+		DynamicHullNode* leaf = NewLeaf(change.pt);
+		DynamicHullNode* parent = NewNode();
+		if (IsLexLess(change.pt, node->minPt))
+		{
+			parent->left = leaf;
+			parent->right = node;
+		}
+		else
+		{
+			parent->left = node;
+			parent->right = leaf;
+		}
+		parent->copyCount = 0;
+		Update(parent);
+
+		change.isTreeChanged = true;
+		change.isUpperChanged = true;
+		change.isLowerChanged = true;
+		return parent;
+	}
+
+	bool isLeft = IsLexLess(change.pt, node->right->minPt);
+	if (isLeft)
+	{
+		node->left = Insert(node->left, change);
+	}
+	else
+	{
+		node->right = Insert(node->right, change);
+	}
+
+	return change.isTreeChanged ? Rebalance(node, isLeft, change) : node;
+}
+
+// **************************************************************************
+DynamicHullNode* DynamicHull::Remove(DynamicHullNode* node, Change& change, bool& isFound)
+{
+	if (node->left == NULL)
+	{
+		isFound = compare_points(node->minPt, change.pt);
+		if (!isFound || --node->copyCount > 0)
+		{
+			return node;
+		}
+
+		FreeNode(node);
+		change.isTreeChanged = true;
+		change.isUpperChanged = true;
+		change.isLowerChanged = true;
+		return NULL;
+	}
+
+	bool isLeft = IsLexLess(change.pt, node->right->minPt);
+	DynamicHullNode* child = Remove(isLeft ? node->left : node->right, change, isFound);
+	if (!change.isTreeChanged)
+	{
+		return node;
+	}
+
+	if (child == NULL) // The sibling takes the place of this node
+	{
+		change.isUpperChanged = IsOnHull(node, 1, isLeft, change.pt);
+		change.isLowerChanged = IsOnHull(node, -1, isLeft, change.pt);
+
+		DynamicHullNode* sibling = isLeft ? node->right : node->left;
+		FreeNode(node);
+		return sibling;
+	}
+
+	if (isLeft)
+	{
+		node->left = child;
+	}
+	else
+	{
+		node->right = child;
+	}
+
+	return Rebalance(node, isLeft, change);
+}
+
+// **************************************************************************
+// Balanced subtree over sorted leaves: halves differ by one leaf at most, heights by one at most.
+DynamicHullNode* DynamicHull::Build(DynamicHullNode** ppLeaves, count_t count)
+{
+	if (count == 1)
+	{
+		return ppLeaves[0];
+	}
+
+	count_t half = count / 2;
+	DynamicHullNode* node = NewNode();
+	node->left = Build(ppLeaves, half);
+	node->right = Build(ppLeaves + half, count - half);
+	node->copyCount = 0;
+	Update(node);
+	return node;
+}
+
+// **************************************************************************
+void DynamicHull::Build(const point* pPoints, int64_t count)
+{
+	Clear();
+	if (count <= 0)
+	{
+		return;
+	}
+
+	std::vector<point> points(pPoints, pPoints + count);
+	std::sort(points.begin(), points.end(), IsLexLess);
+
+	std::vector<DynamicHullNode*> leaves;
+	for (const point& pt : points)
+	{
+		if (!leaves.empty() && compare_points(leaves.back()->minPt, pt))
+		{
+			leaves.back()->copyCount++;
+		}
+		else
+		{
+			leaves.push_back(NewLeaf(pt));
+		}
+	}
+
+	_root = Build(leaves.data(), (count_t)leaves.size());
+	_count = count;
+}
+
+// **************************************************************************
+void DynamicHull::Insert(const point& pt)
+{
+	if (_root == NULL)
+	{
+		_root = NewLeaf(pt);
+	}
+	else
+	{
+		Change change = { pt, true, false, false, false };
+		_root = Insert(_root, change);
+	}
+
+	_count++;
+}
+
+// **************************************************************************
+bool DynamicHull::Remove(const point& pt)
+{
+	if (_root == NULL)
+	{
+		return false;
+	}
+
+	bool isFound;
+	Change change = { pt, false, false, false, false };
+	_root = Remove(_root, change, isFound);
+	if (isFound)
+	{
+		_count--;
+	}
+
+	return isFound;
+}
+
+// **************************************************************************
+int64_t DynamicHull::Count() const
+{
+	return _count;
+}
+
+// **************************************************************************
+// Is the turned pt under (or on) the upper hull of the turned points? Follows the bridges down to the hull
+// edge over pt: left of the bridge, the hull of a node is the hull of its First subtree (same on the right).
+bool DynamicHull::IsUnderChain(const DynamicHullNode* node, int dir, const point& pt)
+{
+	point p = Turn(pt, dir);
+	point a, b;
+
+	while (node->left != NULL)
+	{
+		GetBridge(node, dir, a, b);
+		if (p.x < a.x)
+		{
+			node = First(node, dir);
+		}
+		else if (p.x > b.x)
+		{
+			node = Second(node, dir);
+		}
+		else if (a.x == b.x) // Vertical edge at the left end of the hull, it can go on up in Second
+		{
+			if (p.y <= b.y)
+			{
+				return true;
+			}
+			node = Second(node, dir);
+		}
+		else
+		{
+			return area(a, b, p) <= 0;
+		}
+	}
+
+	a = Turn(node->minPt, dir);
+	return p.x == a.x && p.y <= a.y;
+}
+
+// **************************************************************************
+bool DynamicHull::Contains(const point& pt) const
+{
+	if (_root == NULL)
+	{
+		return false;
+	}
+
+	return IsUnderChain(_root, 1, pt) && IsUnderChain(_root, -1, pt);
+}
+
+// **************************************************************************
+// Along the upper hull, edges turn clockwise: the dot product of the direction with them goes from
+// positive to negative once, at the extreme vertex. The first edge can be vertical (points of the same
+// x are in increasing y): for a horizontal direction its dot product is 0 while the extreme vertex can
+// be after it. A vertical bridge goes on to Second, which keeps b: when the leftmost points are the
+// extreme ones, b is one of them.
+bool DynamicHull::ExtremePoint(double directionX, double directionY, point& result) const
+{
+	if (_root == NULL)
+	{
+		return false;
+	}
+
+	int dir = directionY < 0 ? -1 : 1;
+	double ux = dir * directionX;
+	double uy = dir * directionY;
+
+	const DynamicHullNode* node = _root;
+	point a, b;
+	while (node->left != NULL)
+	{
+		GetBridge(node, dir, a, b);
+		node = (ux * (b.x - a.x) + uy * (b.y - a.y) > 0 || a.x == b.x) ? Second(node, dir) : First(node, dir);
+	}
+
+	result = node->minPt;
+	return true;
+}
+
+// **************************************************************************
+// Append the vertices of the upper hull of the turned points of node that are between pLow and pHigh
+// (turned, NULL for no bound), in the turned lexicographic order.
+void DynamicHull::AppendChain(const DynamicHullNode* node, int dir, const point* pLow, const point* pHigh, std::vector<point>& points)
+{
+	if (node->left == NULL)
+	{
+		point p = Turn(node->minPt, dir);
+		if ((pLow == NULL || !IsLexLess(p, *pLow)) && (pHigh == NULL || !IsLexLess(*pHigh, p)))
+		{
+			points.push_back(node->minPt);
+		}
+		return;
+	}
+
+	point a, b;
+	GetBridge(node, dir, a, b);
+
+	if (pLow == NULL || !IsLexLess(a, *pLow))
+	{
+		AppendChain(First(node, dir), dir, pLow, (pHigh != NULL && IsLexLess(*pHigh, a)) ? pHigh : &a, points);
+	}
+
+	if (pHigh == NULL || !IsLexLess(*pHigh, b))
+	{
+		AppendChain(Second(node, dir), dir, (pLow != NULL && IsLexLess(b, *pLow)) ? pLow : &b, pHigh, points);
+	}
+}
+
+// **************************************************************************
+point* DynamicHull::GetResultAsArray(int64_t& hullPointCount, bool closeThePath)
+{
+	hullPointCount = 0;
+	if (_root == NULL)
+	{
+		return NULL;
+	}
+
+	std::vector<point> upper, lower, points;
+	AppendChain(_root, 1, NULL, NULL, upper);
+	AppendChain(_root, -1, NULL, NULL, lower);
+	std::reverse(lower.begin(), lower.end());
+
+	points.resize(upper.size() + lower.size());
+	std::merge(upper.begin(), upper.end(), lower.begin(), lower.end(), points.begin(), IsLexLess);
+
+	return HullOfSortedPoints(points, closeThePath, hullPointCount);
+}
+
+// **************************************************************************
+extern "C" DynamicHull* dynamicHullCreate()
+{
+	return new DynamicHull();
+}
+
+// **************************************************************************
+extern "C" void dynamicHullInsert(DynamicHull* pHull, point pt)
+{
+	pHull->Insert(pt);
+}
+
+// **************************************************************************
+extern "C" bool dynamicHullRemove(DynamicHull* pHull, point pt)
+{
+	return pHull->Remove(pt);
+}
+
+// **************************************************************************
+extern "C" bool dynamicHullContains(DynamicHull* pHull, point pt)
+{
+	return pHull->Contains(pt);
+}
+
+// **************************************************************************
+extern "C" point* dynamicHullSnapshot(DynamicHull* pHull, bool closeThePath, int64_t& resultCount)
+{
+	return pHull->GetResultAsArray(resultCount, closeThePath);
+}
+
+// **************************************************************************
+extern "C" void dynamicHullDelete(DynamicHull* pHull)
+{
+	delete pHull;
+}
+
+// **************************************************************************
+static void GetLatency(std::vector<double>& durations, DynamicHullLatency& latency)
+{
+	std::sort(durations.begin(), durations.end());
+	count_t count = (count_t)durations.size();
+	latency.p50 = durations[std::min(count - 1, (count_t)(count * 0.5))];
+	latency.p90 = durations[std::min(count - 1, (count_t)(count * 0.9))];
+	latency.p99 = durations[std::min(count - 1, (count_t)(count * 0.99))];
+	latency.p999 = durations[std::min(count - 1, (count_t)(count * 0.999))];
+	latency.max = durations[count - 1];
+}
+
+// **************************************************************************
+extern "C" int64_t dynamicHullLatencyBenchmark(int64_t livePointCount, int64_t operationCount,
+	DynamicHullLatency& insertLatency, DynamicHullLatency& removeLatency, DynamicHullLatency& queryLatency)
+{
+	std::mt19937_64 random(12345);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+	auto nextPoint = [&]()
+	{
+		double angle = distribution(random) * 6.283185307179586;
+		double radius = sqrt(distribution(random));
+		point pt = { radius * cos(angle), radius * sin(angle) };
+		return pt;
+	};
+
+	DynamicHull hull;
+	std::vector<point> livePoints((size_t)livePointCount);
+	for (int64_t n = 0; n < livePointCount; n++)
+	{
+		livePoints[(size_t)n] = nextPoint();
+		hull.Insert(livePoints[(size_t)n]);
+	}
+
+	std::vector<double> insertDurations, removeDurations, queryDurations;
+	insertDurations.reserve((size_t)operationCount);
+	removeDurations.reserve((size_t)operationCount);
+	queryDurations.reserve((size_t)operationCount);
+
+	int64_t insideCount = 0;
+	for (int64_t n = 0; n < operationCount && livePointCount > 0; n++)
+	{
+		size_t index = (size_t)(random() % (uint64_t)livePointCount);
+		point pt = nextPoint();
+		point query = nextPoint();
+
+		double start = omp_get_wtime();
+		hull.Remove(livePoints[index]);
+		double afterRemove = omp_get_wtime();
+		hull.Insert(pt);
+		double afterInsert = omp_get_wtime();
+		insideCount += hull.Contains(query) ? 1 : 0;
+		double afterQuery = omp_get_wtime();
+
+		livePoints[index] = pt;
+		removeDurations.push_back(afterRemove - start);
+		insertDurations.push_back(afterInsert - afterRemove);
+		queryDurations.push_back(afterQuery - afterInsert);
+	}
+
+	DynamicHullLatency empty = { 0, 0, 0, 0, 0 };
+	insertLatency = removeLatency = queryLatency = empty;
+	if (!insertDurations.empty())
+	{
+		GetLatency(insertDurations, insertLatency);
+		GetLatency(removeDurations, removeLatency);
+		GetLatency(queryDurations, queryLatency);
+	}
+
+	return insideCount;
+}
+
+// **************************************************************************
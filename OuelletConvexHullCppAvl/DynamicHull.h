@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include "Point.h"
+
+// Leaf of the tree: one distinct point (and how many times it was inserted).
+// Inner node: bridges of the upper and lower hulls of its subtree, each one joins a vertex
+// of the left subtree hull to a vertex of the right subtree hull. Bridge ends are copied in
+// the node, finding a bridge then reads one node per step.
+struct DynamicHullNode
+{
+	DynamicHullNode* left; // NULL for a leaf
+	DynamicHullNode* right;
+	point minPt; // Lowest point (lexicographic) of the subtree, the point itself for a leaf
+	point upperLeft;
+	point upperRight;
+	point lowerLeft;
+	point lowerRight;
+	count_t copyCount; // Leaf only
+	int height; // 0 for a leaf
+};
+
+// Fully dynamic convex hull: points can be inserted and deleted in any order.
+//
+// Overmars and van Leeuwen hierarchy: points are the leaves of a balanced (AVL) tree, in lexicographic
+// order, and each inner node keeps the bridges that join the hulls of its two subtrees. The hull of a
+// subtree is never stored, it is the hull of its left subtree up to the left end of the bridge followed by
+// the hull of its right subtree from the right end of the bridge. A bridge is found by descending both
+// subtrees at once, each step drops half of one of them: O(log n).
+// Insert and delete rebuild the bridges of one root to leaf path: O(log^2 n). Above the first node whose hull
+// does not change (the point is inside it), bridges stay as they are: inner points are cheaper.
+// Containment and extreme point queries follow bridges from the root: O(log n).
+// The full hull is read in O(h log n).
+class DynamicHull
+{
+private:
+	DynamicHullNode* _root = NULL;
+	count_t _count = 0;
+
+	std::vector<DynamicHullNode*> _nodeBlocks;
+	DynamicHullNode* _freeNodes = NULL; // Linked by "left"
+
+	DynamicHullNode* NewNode();
+	DynamicHullNode* NewLeaf(const point& pt);
+	void FreeNode(DynamicHullNode* node);
+
+	// What an insert or a remove changed, updated from the leaf up to the root
+	struct Change
+	{
+		point pt;
+		bool isInsert;
+		bool isTreeChanged; // A leaf was added or removed
+		bool isUpperChanged; // The upper hull of the subtree changed
+		bool isLowerChanged;
+	};
+
+	static void Update(DynamicHullNode* node);
+	static void FindBridge(const DynamicHullNode* node, int dir, point& first, point& second);
+	static bool IsOnHull(const DynamicHullNode* node, int dir, bool isLeft, const point& pt);
+	static void RefreshBridge(DynamicHullNode* node, int dir, bool isLeft, const Change& change, bool& isHullChanged);
+	static DynamicHullNode* RotateLeft(DynamicHullNode* node);
+	static DynamicHullNode* RotateRight(DynamicHullNode* node);
+	static DynamicHullNode* Rebalance(DynamicHullNode* node, bool isLeft, Change& change);
+
+	DynamicHullNode* Build(DynamicHullNode** ppLeaves, count_t count);
+	DynamicHullNode* Insert(DynamicHullNode* node, Change& change);
+	DynamicHullNode* Remove(DynamicHullNode* node, Change& change, bool& isFound);
+
+	static bool IsUnderChain(const DynamicHullNode* node, int dir, const point& pt);
+	static void AppendChain(const DynamicHullNode* node, int dir, const point* pLow, const point* pHigh, std::vector<point>& points);
+
+public:
+	DynamicHull();
+	~DynamicHull();
+
+	void Build(const point* pPoints, int64_t count); // Replace the points by these ones: sorted then built bottom up, O(n log n)
+	void Insert(const point& pt);
+	bool Remove(const point& pt); // false if the point is not there (a point inserted many times is removed once)
+	void Clear();
+	int64_t Count() const; // Count of points, including the repeated ones
+
+	bool Contains(const point& pt) const; // Inside or on the border of the hull
+	bool ExtremePoint(double directionX, double directionY, point& result) const; // Farthest point in that direction, false when empty
+
+	point* GetResultAsArray(int64_t& count, bool closeThePath = true); // Same layout as OuelletHull. Free with delete[].
+};
+
+// Latencies of one kind of operation, in seconds
+struct DynamicHullLatency
+{
+	double p50;
+	double p90;
+	double p99;
+	double p999;
+	double max;
+};
+
+extern "C"
+{
+	DynamicHull* dynamicHullCreate();
+	void dynamicHullInsert(DynamicHull* pHull, point pt);
+	bool dynamicHullRemove(DynamicHull* pHull, point pt);
+	bool dynamicHullContains(DynamicHull* pHull, point pt);
+	point* dynamicHullSnapshot(DynamicHull* pHull, bool closeThePath, int64_t& resultCount);
+	void dynamicHullDelete(DynamicHull* pHull);
+
+	// Fill a hull with livePointCount random points (uniform in a disk), then time operationCount rounds
+	// of: remove a random live point, insert a new one, query the containment of a random point.
+	// Returns the count of queries inside the hull.
+	int64_t dynamicHullLatencyBenchmark(int64_t livePointCount, int64_t operationCount,
+		DynamicHullLatency& insertLatency, DynamicHullLatency& removeLatency, DynamicHullLatency& queryLatency);
+}
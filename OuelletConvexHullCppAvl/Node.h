@@ -9,9 +9,10 @@ class AvlNode
 public:
 	T key;
 	int balance;
+	int height; // Cached, a leaf has height 0
 	AvlNode *left, *right, *parent;
 
-	AvlNode(T k, AvlNode *p) : key(k), balance(0), parent(p), left(NULL), right(NULL)
+	AvlNode(T k, AvlNode *p) : key(k), balance(0), height(0), parent(p), left(NULL), right(NULL)
 	{
 	}
 
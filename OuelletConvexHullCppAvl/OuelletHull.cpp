@@ -84,10 +84,17 @@ extern "C" point* ouelletHull(point* pArrayOfPoint, int count, bool closeThePath
 }
 
 // **************************************************************************
-int ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int count)
+extern "C" point* ouelletHull64(point* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount)
 {
-	int resultCount;
-	OuelletHull convexHull(pArrayOfPoint, count, true);
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, closeThePath);
+	return convexHull.GetResultAsArray(resultCount);
+}
+
+// **************************************************************************
+int64_t ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int64_t count)
+{
+	int64_t resultCount;
+	OuelletHull convexHull(pArrayOfPoint, (count_t)count, true);
 	convexHull.GetResultAsArray(resultCount);
 	return resultCount;
 }
@@ -109,7 +116,7 @@ void OuelletHull::CalcConvexHull()
 
 	pPt++;
 
-	for (int n = _countOfPoint - 1; n > 0; n--) // -1 because 0 bound.
+	for (count_t n = _countOfPoint - 1; n > 0; n--) // -1 because 0 bound.
 	{
 		point& pt = *pPt;
 
@@ -294,15 +301,15 @@ void OuelletHull::CalcConvexHull()
 	// *************************
 
 	// Calc per quadrant
-	int index;
-	int indexLow;
-	int indexHi;
+	count_t index;
+	count_t indexLow;
+	count_t indexHi;
 
 	// Currently hardcoded, could be calculated or pass as argument by user, dynamic, grow as needed
 
 	pPt = _pPoints;
 
-	for (int n = _countOfPoint - 1; n >= 0; n--) // -1 because 0 bound.
+	for (count_t n = _countOfPoint - 1; n >= 0; n--) // -1 because 0 bound.
 	{
 		point& pt = *pPt;
 
@@ -367,7 +374,7 @@ void OuelletHull::CalcConvexHull()
 			}
 
 			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q1hullCount - 1;
+			count_t maxIndexHi = q1hullCount - 1;
 			while (indexHi < maxIndexHi)
 			{
 				if (right_turn(pt, q1pHullPoints[indexHi + 1], q1pHullPoints[indexHi]))
@@ -458,7 +465,7 @@ void OuelletHull::CalcConvexHull()
 			}
 
 			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q2hullCount - 1;
+			count_t maxIndexHi = q2hullCount - 1;
 			while (indexHi < maxIndexHi)
 			{
 				if (right_turn(pt, q2pHullPoints[indexHi + 1], q2pHullPoints[indexHi]))
@@ -550,7 +557,7 @@ void OuelletHull::CalcConvexHull()
 			}
 
 			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q3hullCount - 1;
+			count_t maxIndexHi = q3hullCount - 1;
 			while (indexHi < maxIndexHi)
 			{
 				if (right_turn(pt, q3pHullPoints[indexHi + 1], q3pHullPoints[indexHi]))
@@ -642,7 +649,7 @@ void OuelletHull::CalcConvexHull()
 			}
 
 			// Find upper bound (remove point invalidate by the new one that come after)
-			int maxIndexHi = q4hullCount - 1;
+			count_t maxIndexHi = q4hullCount - 1;
 			while (indexHi < maxIndexHi)
 			{
 				if (right_turn(pt, q4pHullPoints[indexHi + 1], q4pHullPoints[indexHi]))
@@ -682,14 +689,14 @@ void OuelletHull::CalcConvexHull()
 }
 
 // **************************************************************************
-void OuelletHull::InsertPoint(point*& pPoint, int index, point& pt, int& count, int& capacity)
+void OuelletHull::InsertPoint(point*& pPoint, count_t index, point& pt, count_t& count, count_t& capacity)
 {
 	// make some room to insert the point. make sure to not reach capacity and/or adjust it
 	if (count >= capacity)
 	{
 		// Should make some room
 		//int newCapacity = capacity + _quadrantHullPointArrayGrowSize; // Very bad in the worse case. Fallback to regular way of growing list capacity
-		int newCapacity = capacity * 2;
+		count_t newCapacity = capacity * 2;
 		point* newPointArray = new point[newCapacity];
 		memmove(newPointArray, pPoint, capacity * sizeof(point));
 		delete pPoint;
@@ -706,14 +713,14 @@ void OuelletHull::InsertPoint(point*& pPoint, int index, point& pt, int& count,
 
 // **************************************************************************
 /// Remove every item in from index start to indexEnd inclusive 
-void OuelletHull::RemoveRange(point* pPoint, int indexStart, int indexEnd, int &count)
+void OuelletHull::RemoveRange(point* pPoint, count_t indexStart, count_t indexEnd, count_t &count)
 {
 	memmove(&(pPoint[indexStart]), &(pPoint[indexEnd + 1]), (count - indexEnd) * sizeof(point));
 	count -= (indexEnd - indexStart + 1);
 }
 
 // **************************************************************************
-OuelletHull::OuelletHull(point* points, int countOfPoint, bool shouldCloseTheGraph)
+OuelletHull::OuelletHull(point* points, count_t countOfPoint, bool shouldCloseTheGraph)
 {
 	_pPoints = points;
 	_countOfPoint = countOfPoint;
@@ -733,6 +740,15 @@ OuelletHull::~OuelletHull()
 
 // **************************************************************************
 point* OuelletHull::GetResultAsArray(int& hullPointCount)
+{
+	int64_t count;
+	point* results = GetResultAsArray(count);
+	hullPointCount = (int)count;
+	return results;
+}
+
+// **************************************************************************
+point* OuelletHull::GetResultAsArray(int64_t& hullPointCount)
 {
 	hullPointCount = 0;
 	if (this->_countOfPoint == 0)
@@ -740,14 +756,14 @@ point* OuelletHull::GetResultAsArray(int& hullPointCount)
 		return NULL;
 	}
 
-	unsigned int indexQ1Start;
-	unsigned int indexQ2Start;
-	int indexQ3Start;
-	int indexQ4Start;
-	int indexQ1End;
-	int indexQ2End;
-	int indexQ3End;
-	int indexQ4End;
+	count_t indexQ1Start;
+	count_t indexQ2Start;
+	count_t indexQ3Start;
+	count_t indexQ4Start;
+	count_t indexQ1End;
+	count_t indexQ2End;
+	count_t indexQ3End;
+	count_t indexQ4End;
 
 	indexQ1Start = 0;
 	indexQ1End = q1hullCount - 1;
@@ -843,7 +859,7 @@ point* OuelletHull::GetResultAsArray(int& hullPointCount)
 		indexQ1Start++;
 	}
 
-	int countOfFinalHullPoint = (indexQ1End - indexQ1Start) +
+	count_t countOfFinalHullPoint = (indexQ1End - indexQ1Start) +
 		(indexQ2End - indexQ2Start) +
 		(indexQ3End - indexQ3Start) +
 		(indexQ4End - indexQ4Start) + 4;
@@ -860,27 +876,27 @@ point* OuelletHull::GetResultAsArray(int& hullPointCount)
 
 	point* results = new point[countOfFinalHullPoint];
 
-	int resIndex = 0;
+	count_t resIndex = 0;
 
-	for (int n = indexQ1Start; n <= indexQ1End; n++)
+	for (count_t n = indexQ1Start; n <= indexQ1End; n++)
 	{
 		results[resIndex] = q1pHullPoints[n];
 		resIndex++;
 	}
 
-	for (int n = indexQ2Start; n <= indexQ2End; n++)
+	for (count_t n = indexQ2Start; n <= indexQ2End; n++)
 	{
 		results[resIndex] = q2pHullPoints[n];
 		resIndex++;
 	}
 
-	for (int n = indexQ3Start; n <= indexQ3End; n++)
+	for (count_t n = indexQ3Start; n <= indexQ3End; n++)
 	{
 		results[resIndex] = q3pHullPoints[n];
 		resIndex++;
 	}
 
-	for (int n = indexQ4Start; n <= indexQ4End; n++)
+	for (count_t n = indexQ4Start; n <= indexQ4End; n++)
 	{
 		results[resIndex] = q4pHullPoints[n];
 		resIndex++;
@@ -19,45 +19,47 @@ private:
 	static const int _quadrantHullPointArrayGrowSize = 1000;
 
 	point* _pPoints;
-	int _countOfPoint;
+	count_t _countOfPoint;
 	bool _shouldCloseTheGraph;
 
 	point* q1pHullPoints;
 	point* q1pHullLast;
-	int q1hullCapacity;
-	int q1hullCount = 0;
+	count_t q1hullCapacity;
+	count_t q1hullCount = 0;
 
 	point* q2pHullPoints;
 	point* q2pHullLast;
-	int q2hullCapacity;
-	int q2hullCount = 0;
+	count_t q2hullCapacity;
+	count_t q2hullCount = 0;
 
 	point* q3pHullPoints;
 	point* q3pHullLast;
-	int q3hullCapacity;
-	int q3hullCount = 0;
+	count_t q3hullCapacity;
+	count_t q3hullCount = 0;
 
 	point* q4pHullPoints;
 	point* q4pHullLast;
-	int q4hullCapacity;
-	int q4hullCount = 0;
+	count_t q4hullCapacity;
+	count_t q4hullCount = 0;
 
 	void CalcConvexHull();
 
-	inline static void InsertPoint(point*& pPoint, int index, point& pt, int& count, int& capacity);
-	inline static void RemoveRange(point* pPoint, int indexStart, int indexEnd, int &count);
+	inline static void InsertPoint(point*& pPoint, count_t index, point& pt, count_t& count, count_t& capacity);
+	inline static void RemoveRange(point* pPoint, count_t indexStart, count_t indexEnd, count_t &count);
 
 public:
-	OuelletHull(point* points, int countOfPoint, bool shouldCloseTheGraph = true);
+	OuelletHull(point* points, count_t countOfPoint, bool shouldCloseTheGraph = true);
 	~OuelletHull();
 	point* GetResultAsArray(int& count);
+	point* GetResultAsArray(int64_t& count);
 };
 
-int ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int count);
+int64_t ouelletHullForTimeCheckOnly(point* pArrayOfPoint, int64_t count);
 
 extern "C" 
 {
 	point* ouelletHull(point* pArrayOfPoint, int count, bool closeThePath, int& resultCount);
+	point* ouelletHull64(point* pArrayOfPoint, int64_t count, bool closeThePath, int64_t& resultCount);
 //	array<ManagedPoint>^ ouelletHullManaged(point* pArrayOfPoint, int count);
 }
 
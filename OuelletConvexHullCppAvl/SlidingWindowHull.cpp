@@ -0,0 +1,272 @@
+#include "Stdafx.h"
+#include "SlidingWindowHull.h"
+#include "SortedHull.h"
+#include <algorithm>
+
+// **************************************************************************
+static bool PointLexLessFunc(const point& a, const point& b)
+{
+	return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// **************************************************************************
+static void AppendChain(const HullChainTree& chain, std::vector<point>& points)
+{
+	for (AvlNode<point>* n = chain.firstNode(); n != NULL; n = HullChainTree::nextNode(n))
+	{
+		points.push_back(n->key);
+	}
+}
+
+// **************************************************************************
+SlidingWindowHull::SlidingWindowHull(int64_t maxCount)
+{
+	_maxCount = (count_t)maxCount;
+}
+
+// **************************************************************************
+SlidingWindowHull::~SlidingWindowHull()
+{
+}
+
+// **************************************************************************
+// Insert pt in an upper (side = 1) or lower (side = -1) chain if it is outside of it, then remove the
+// vertices it makes concave. Removed vertices are pushed to pRemoved when it is not NULL.
+bool SlidingWindowHull::InsertInChain(HullChainTree& chain, const point& pt, int side, std::vector<point>* pRemoved, count_t& removedCount)
+{
+	removedCount = 0;
+
+	AvlNode<point>* pSameX = chain.findNode(pt);
+	if (pSameX != NULL)
+	{
+		if (side * (pSameX->key.y - pt.y) >= 0)
+		{
+			return false; // Dominated by the vertex already there
+		}
+
+		if (pRemoved != NULL)
+		{
+			pRemoved->push_back(pSameX->key);
+		}
+		removedCount++;
+		chain.deleteKey(pt);
+	}
+	else
+	{
+		AvlNode<point>* pLow = chain.lowerNode(pt);
+		AvlNode<point>* pHi = chain.higherNode(pt);
+		if (pLow != NULL && pHi != NULL && side * area(pLow->key, pHi->key, pt) <= 0)
+		{
+			return false; // Under (or over for the lower chain) the segment of the chain
+		}
+	}
+
+	chain.insert(pt);
+
+	// Find lower bound (remove points invalidated by the new one that come before)
+	while (true)
+	{
+		AvlNode<point>* pLow = chain.lowerNode(pt);
+		if (pLow == NULL)
+		{
+			break;
+		}
+		AvlNode<point>* pLowLow = HullChainTree::previousNode(pLow);
+		if (pLowLow == NULL || side * area(pLowLow->key, pLow->key, pt) < 0)
+		{
+			break;
+		}
+
+		if (pRemoved != NULL)
+		{
+			pRemoved->push_back(pLow->key);
+		}
+		removedCount++;
+		chain.deleteKey(pLow->key);
+	}
+
+	// Find upper bound (remove points invalidated by the new one that come after)
+	while (true)
+	{
+		AvlNode<point>* pHi = chain.higherNode(pt);
+		if (pHi == NULL)
+		{
+			break;
+		}
+		AvlNode<point>* pHiHi = HullChainTree::nextNode(pHi);
+		if (pHiHi == NULL || side * area(pt, pHi->key, pHiHi->key) < 0)
+		{
+			break;
+		}
+
+		if (pRemoved != NULL)
+		{
+			pRemoved->push_back(pHi->key);
+		}
+		removedCount++;
+		chain.deleteKey(pHi->key);
+	}
+
+	return true;
+}
+
+// **************************************************************************
+void SlidingWindowHull::Push(const point& pt, double timestamp)
+{
+	Entry entry = { pt, timestamp };
+	_back.push_back(entry);
+
+	count_t removedCount;
+	InsertInChain(_backUpper, pt, 1, NULL, removedCount);
+	InsertInChain(_backLower, pt, -1, NULL, removedCount);
+
+	if (_maxCount > 0 && Count() > _maxCount)
+	{
+		ExpireOldest();
+	}
+}
+
+// **************************************************************************
+// The back block becomes the front block. Its chains are built from the newest point to the oldest one
+// so that the oldest point is always the top of the undo log.
+void SlidingWindowHull::MoveBackToFront()
+{
+	_front.swap(_back);
+	_back.clear();
+	_backUpper.clear();
+	_backLower.clear();
+
+	_frontStart = 0;
+	_frontUpper.clear();
+	_frontLower.clear();
+	_frontUndo.clear();
+	_frontRemoved.clear();
+
+	for (count_t n = (count_t)_front.size() - 1; n >= 0; n--)
+	{
+		UndoRecord record;
+		record.isInUpper = InsertInChain(_frontUpper, _front[n].pt, 1, &_frontRemoved, record.upperRemovedCount);
+		record.isInLower = InsertInChain(_frontLower, _front[n].pt, -1, &_frontRemoved, record.lowerRemovedCount);
+		_frontUndo.push_back(record);
+	}
+}
+
+// **************************************************************************
+void SlidingWindowHull::ExpireOldest()
+{
+	if (_frontStart == (count_t)_front.size())
+	{
+		MoveBackToFront();
+	}
+
+	const point& pt = _front[_frontStart].pt;
+	UndoRecord record = _frontUndo.back();
+	_frontUndo.pop_back();
+
+	// Undo in the reverse order of the insertion: lower chain first, its removed points are on top
+	if (record.isInLower)
+	{
+		_frontLower.deleteKey(pt);
+	}
+	for (count_t n = 0; n < record.lowerRemovedCount; n++)
+	{
+		_frontLower.insert(_frontRemoved.back());
+		_frontRemoved.pop_back();
+	}
+
+	if (record.isInUpper)
+	{
+		_frontUpper.deleteKey(pt);
+	}
+	for (count_t n = 0; n < record.upperRemovedCount; n++)
+	{
+		_frontUpper.insert(_frontRemoved.back());
+		_frontRemoved.pop_back();
+	}
+
+	_frontStart++;
+	if (_frontStart == (count_t)_front.size())
+	{
+		_front.clear();
+		_frontStart = 0;
+	}
+}
+
+// **************************************************************************
+int64_t SlidingWindowHull::Expire(double before)
+{
+	int64_t countRemoved = 0;
+
+	while (Count() > 0)
+	{
+		const Entry& oldest = _frontStart < (count_t)_front.size() ? _front[_frontStart] : _back.front();
+		if (oldest.timestamp >= before)
+		{
+			break;
+		}
+
+		ExpireOldest();
+		countRemoved++;
+	}
+
+	return countRemoved;
+}
+
+// **************************************************************************
+int64_t SlidingWindowHull::Count() const
+{
+	return ((count_t)_front.size() - _frontStart) + (count_t)_back.size();
+}
+
+// **************************************************************************
+point* SlidingWindowHull::GetResultAsArray(int64_t& hullPointCount, bool closeThePath)
+{
+	// Every chain is sorted by x, merge them all in lexicographic order
+	std::vector<point> upper, lower, points;
+	AppendChain(_frontUpper, upper);
+	count_t middle = (count_t)upper.size();
+	AppendChain(_backUpper, upper);
+	std::inplace_merge(upper.begin(), upper.begin() + middle, upper.end(), PointLexLessFunc);
+
+	AppendChain(_frontLower, lower);
+	middle = (count_t)lower.size();
+	AppendChain(_backLower, lower);
+	std::inplace_merge(lower.begin(), lower.begin() + middle, lower.end(), PointLexLessFunc);
+
+	points.resize(upper.size() + lower.size());
+	std::merge(upper.begin(), upper.end(), lower.begin(), lower.end(), points.begin(), PointLexLessFunc);
+
+	return HullOfSortedPoints(points, closeThePath, hullPointCount);
+}
+
+// **************************************************************************
+extern "C" SlidingWindowHull* slidingWindowHullCreate(int64_t maxCount)
+{
+	return new SlidingWindowHull(maxCount);
+}
+
+// **************************************************************************
+extern "C" void slidingWindowHullPush(SlidingWindowHull* pWindow, point pt, double timestamp)
+{
+	pWindow->Push(pt, timestamp);
+}
+
+// **************************************************************************
+extern "C" int64_t slidingWindowHullExpire(SlidingWindowHull* pWindow, double before)
+{
+	return pWindow->Expire(before);
+}
+
+// **************************************************************************
+extern "C" point* slidingWindowHullSnapshot(SlidingWindowHull* pWindow, bool closeThePath, int64_t& resultCount)
+{
+	return pWindow->GetResultAsArray(resultCount, closeThePath);
+}
+
+// **************************************************************************
+extern "C" void slidingWindowHullDelete(SlidingWindowHull* pWindow)
+{
+	delete pWindow;
+}
+
+// **************************************************************************
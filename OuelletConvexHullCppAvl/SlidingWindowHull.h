@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include "Point.h"
+#include "AvlTree.h"
+
+// Order of the vertices of one hull chain: a chain has at most one vertex per x
+struct PointXLess
+{
+	bool operator()(const point& a, const point& b) const { return a.x < b.x; }
+};
+
+typedef AvlTree<point, PointXLess> HullChainTree;
+
+// Convex hull of the last points of a time ordered stream (the last N points and/or the points
+// not older than a timestamp).
+//
+// Works like a queue made of two stacks:
+// - New points go to the back block, whose hull only grows (insert only chains).
+// - Points expire from the front block. When it is empty, the whole back block becomes the front block
+//   and its chains are rebuilt from the newest point to the oldest one while logging what each insertion
+//   did (inserted or not, vertices removed). The oldest point is then always the last insertion and
+//   expiring it is an undo of the log top.
+// Each point is inserted twice and undone once, each step is O(log h) on the AvlTree chains, so push and
+// expire are O(log n) amortized. The snapshot merges the front and back hulls in O(h).
+class SlidingWindowHull
+{
+private:
+	struct Entry
+	{
+		point pt;
+		double timestamp;
+	};
+
+	struct UndoRecord
+	{
+		bool isInUpper;
+		bool isInLower;
+		count_t upperRemovedCount;
+		count_t lowerRemovedCount;
+	};
+
+	count_t _maxCount;
+
+	std::vector<Entry> _front; // Oldest first, [_frontStart, size) are alive
+	count_t _frontStart = 0;
+	HullChainTree _frontUpper;
+	HullChainTree _frontLower;
+	std::vector<UndoRecord> _frontUndo; // Top is the oldest alive point of the front block
+	std::vector<point> _frontRemoved;
+
+	std::vector<Entry> _back;
+	HullChainTree _backUpper;
+	HullChainTree _backLower;
+
+	static bool InsertInChain(HullChainTree& chain, const point& pt, int side, std::vector<point>* pRemoved, count_t& removedCount);
+	void MoveBackToFront();
+	void ExpireOldest();
+
+public:
+	SlidingWindowHull(int64_t maxCount = 0); // 0: no limit on the count, points only leave through Expire
+	~SlidingWindowHull();
+
+	void Push(const point& pt, double timestamp);
+	int64_t Expire(double before); // Remove every point older than "before", returns the count of removed points
+	int64_t Count() const;
+
+	point* GetResultAsArray(int64_t& count, bool closeThePath = true); // Snapshot, same layout as OuelletHull. Free with delete[].
+};
+
+extern "C"
+{
+	SlidingWindowHull* slidingWindowHullCreate(int64_t maxCount);
+	void slidingWindowHullPush(SlidingWindowHull* pWindow, point pt, double timestamp);
+	int64_t slidingWindowHullExpire(SlidingWindowHull* pWindow, double before);
+	point* slidingWindowHullSnapshot(SlidingWindowHull* pWindow, bool closeThePath, int64_t& resultCount);
+	void slidingWindowHullDelete(SlidingWindowHull* pWindow);
+}
@@ -0,0 +1,73 @@
+#include "Stdafx.h"
+#include "SortedHull.h"
+
+// **************************************************************************
+point* HullOfSortedPoints(const std::vector<point>& points, bool closeThePath, int64_t& hullPointCount)
+{
+	hullPointCount = 0;
+
+	count_t count = (count_t)points.size();
+	if (count == 0)
+	{
+		return NULL;
+	}
+
+	if (compare_points(points[0], points[count - 1])) // Only one point, or many times the same one
+	{
+		hullPointCount = 1;
+		return new point[1]{ points[0] };
+	}
+
+	// Lower hull then upper hull
+	std::vector<point> hull(2 * count);
+	count_t k = 0;
+	for (count_t n = 0; n < count; n++)
+	{
+		while (k >= 2 && area(hull[k - 2], hull[k - 1], points[n]) <= 0)
+		{
+			k--;
+		}
+		if (k == 1 && compare_points(hull[0], points[n]))
+		{
+			continue;
+		}
+		hull[k++] = points[n];
+	}
+
+	count_t indexRightmost = k - 1;
+	for (count_t n = count - 2, lowerCount = k + 1; n >= 0; n--)
+	{
+		while (k >= lowerCount && area(hull[k - 2], hull[k - 1], points[n]) <= 0)
+		{
+			k--;
+		}
+		if (k == lowerCount - 1 && compare_points(hull[k - 1], points[n]))
+		{
+			continue;
+		}
+		hull[k++] = points[n];
+	}
+	k--; // Last one is the first one
+
+	// Same layout as OuelletHull: start at the rightmost (then highest) vertex
+	count_t countOfFinalHullPoint = closeThePath ? k + 1 : k;
+	point* results = new point[countOfFinalHullPoint];
+	count_t resIndex = 0;
+	for (count_t n = indexRightmost; n < k; n++)
+	{
+		results[resIndex++] = hull[n];
+	}
+	for (count_t n = 0; n < indexRightmost; n++)
+	{
+		results[resIndex++] = hull[n];
+	}
+	if (closeThePath)
+	{
+		results[resIndex++] = results[0];
+	}
+
+	hullPointCount = resIndex;
+	return results;
+}
+
+// **************************************************************************
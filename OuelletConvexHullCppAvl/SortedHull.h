@@ -0,0 +1,10 @@
+#pragma once
+
+#include <vector>
+#include "Point.h"
+
+// Convex hull of points already sorted in lexicographic order (x then y), duplicates allowed.
+// Andrew's monotone chain, O(n). The result has the same layout as OuelletHull::GetResultAsArray:
+// counter clockwise, starting at the rightmost (then highest) vertex, closed if asked.
+// Returns NULL for no point. Free with delete[].
+point* HullOfSortedPoints(const std::vector<point>& points, bool closeThePath, int64_t& hullPointCount);
@@ -12,9 +12,9 @@
 
 /* Generate i.u.d. points in the unit disk
 */
-void generate_disk_points(point *s, int n)
+void generate_disk_points_64(point *s, int64_t n)
 {
-	int i;
+	count_t i;
 
 	srand((unsigned int)time(NULL));
 	for (i = 0; i < n; i++) {
@@ -27,10 +27,10 @@ void generate_disk_points(point *s, int n)
 
 /* Generate i.u.d. points in the unit disk
 */
-void generate_circle_points(point *s, int n)
+void generate_circle_points_64(point *s, int64_t n)
 {
 	double theta;
-	int i;
+	count_t i;
 
 	srand((unsigned int)time(NULL));
 	for (i = 0; i < n; i++) {
@@ -42,9 +42,9 @@ void generate_circle_points(point *s, int n)
 
 /* Generate points on the line (0,0), (1,1)
 */
-  void generate_hvline_points(point *s, int n)
+  void generate_hvline_points_64(point *s, int64_t n)
 {
-	int i;
+	count_t i;
 
 	srand((unsigned int)time(NULL));
 	for (i = 0; i < n; i++) {
@@ -55,9 +55,9 @@ void generate_circle_points(point *s, int n)
 
 /* Generate points on the line (0,0), (1,1)
 */
-  void generate_hline_points(point *s, int n)
+  void generate_hline_points_64(point *s, int64_t n)
 {
-	int i;
+	count_t i;
 
 	srand((unsigned int)time(NULL));
 	for (i = 0; i < n; i++) {
@@ -68,9 +68,9 @@ void generate_circle_points(point *s, int n)
 
 /* Generate points on the line (0,0), (1,1)
 */
-  void generate_vline_points(point *s, int n)
+  void generate_vline_points_64(point *s, int64_t n)
 {
-	int i;
+	count_t i;
 
 	srand((unsigned int)time(NULL));
 	for (i = 0; i < n; i++) {
@@ -81,9 +81,9 @@ void generate_circle_points(point *s, int n)
 
 /* Generate i.u.d. points in the x times y rectangle 
 */
-  void generate_square_points(point *s, int n)
+  void generate_square_points_64(point *s, int64_t n)
 {
-	int i;
+	count_t i;
 
 	srand((unsigned int)time(NULL));
 	for (i = 0; i < n; i++) {
@@ -92,4 +92,32 @@ void generate_circle_points(point *s, int n)
 	}
 }
 
+void generate_disk_points(point *s, int n)
+{
+	generate_disk_points_64(s, n);
+}
+
+void generate_circle_points(point *s, int n)
+{
+	generate_circle_points_64(s, n);
+}
+
+void generate_hvline_points(point *s, int n)
+{
+	generate_hvline_points_64(s, n);
+}
+
+void generate_hline_points(point *s, int n)
+{
+	generate_hline_points_64(s, n);
+}
 
+void generate_vline_points(point *s, int n)
+{
+	generate_vline_points_64(s, n);
+}
+
+void generate_square_points(point *s, int n)
+{
+	generate_square_points_64(s, n);
+}
@@ -16,25 +16,31 @@ extern "C" {  // only need to export C interface if
 	/* Generate i.u.d. points in the unit disk
 	*/
 	DllExport void generate_disk_points(point *s, int n);
+	DllExport void generate_disk_points_64(point *s, int64_t n);
 
 	/* Generate i.u.d. points in the unit disk
 	*/
 	DllExport void generate_circle_points(point *s, int n);
+	DllExport void generate_circle_points_64(point *s, int64_t n);
 
 	/* Generate points on the line (0,0), (1,1)
 	*/
 	DllExport void generate_hvline_points(point *s, int n);
+	DllExport void generate_hvline_points_64(point *s, int64_t n);
 
 	/* Generate points on the line (0,0), (1,1)
 	*/
 	DllExport void generate_hline_points(point *s, int n);
+	DllExport void generate_hline_points_64(point *s, int64_t n);
 
 	/* Generate points on the line (0,0), (1,1)
 	*/
 	DllExport void generate_vline_points(point *s, int n);
+	DllExport void generate_vline_points_64(point *s, int64_t n);
 	/* Generate i.u.d. points in the x times y rectangle 
 	*/
 	DllExport void generate_square_points(point *s, int n);
+	DllExport void generate_square_points_64(point *s, int64_t n);
 #ifdef __cplusplus
 }
 #endif
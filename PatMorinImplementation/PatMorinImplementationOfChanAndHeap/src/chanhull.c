@@ -26,9 +26,9 @@
  * candidates for the lower hull and one which contains all candidates
  * for the upper hull.  Returns the index where the second set begins.
  */
-static int partition(point *s, int n)
+static count_t partition(point *s, count_t n)
 {
-	int i, l = 0, r = 0;
+	count_t i, l = 0, r = 0;
 	point a, b, tmp;
 
 	/* find the highest leftmost point and lowest rightmost point */
@@ -57,336 +57,457 @@ static int partition(point *s, int n)
 	return n;
 }
 
-/* Compute the projection of c onto the line through a and b */
-#define projection(a, b, c) { (c).x = 0; (c).y = 0; }
+/* Compare the slopes of the lines through a and b and through c and d,
+ * both given with their left endpoint first.  Vertical lines have the
+ * greatest slope. */
+#define slope_cmp(a, b, c, d) sign(((b).y - (a).y) * ((d).x - (c).x) \
+                                   - ((d).y - (c).y) * ((b).x - (a).x))
 
-/* Compute a point on the line orthogonal to the line through a and b
- * that contains the point c */
-#define orthogonal(a, b, c, d) { \
-   (d).x = ((a).y - (b).y) + (c).x; \
-   (d).y = -((a).x - (b).x) + (c).y;  }
+/* Utility for swapping two pairs of points */
+#define swap_pairs(s, i, j, c) { swap(s[2 * (i)], s[2 * (j)], c); \
+                                 swap(s[2 * (i) + 1], s[2 * (j) + 1], c); }
 
-/* Compare the slopes between the two lines */
-#define slope_cmp(a, b, c, d) (-1)
+/* Pseudo random numbers for pivots, state kept by the caller (xorshift) */
+static count_t next_random(uint64_t *state, count_t n)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return (count_t)(*state % (uint64_t)n);
+}
 
-/* Place the point p at location i in s, if necessary, add two elements
- * to the stack
+/* Rearrange the m pairs (s[2i], s[2i+1]) so that the pair with the k-th
+ * smallest slope is at index k, pairs with smaller or equal slopes
+ * before it and pairs with greater or equal slopes after it
+ * (quickselect, expected O(m)).
  */
-static int place(point p, point *s, int i, int *r, int *eof,
-	point *stack, int m)
+static void select_slope(point *s, count_t m, count_t k, uint64_t *random)
 {
-	int j;
-
-	for (j = 0; j < 3; j++) {
-		assert(r[j] % 2 == 0);
-		if (i == r[j] && r[j] < eof[j]) {
-			stack[2 * m] = s[r[j]++];
-			stack[2 * m + 1] = s[r[j]++];
-			m++;
+	count_t lo = 0, hi = m - 1, i;
+	point a, b, tmp;
+
+	while (lo < hi) {
+		i = lo + next_random(random, hi - lo + 1);
+		swap_pairs(s, lo, i, tmp);
+		a = s[2 * lo];
+		b = s[2 * lo + 1];
+
+		/* three way partition around the slope of (a, b) */
+		count_t lt = lo, gt = hi;
+		i = lo + 1;
+		while (i <= gt) {
+			int ret = slope_cmp(s[2 * i], s[2 * i + 1], a, b);
+			if (ret < 0) {
+				swap_pairs(s, lt, i, tmp);
+				lt++;
+				i++;
+			}
+			else if (ret > 0) {
+				swap_pairs(s, i, gt, tmp);
+				gt--;
+			}
+			else {
+				i++;
+			}
+		}
+
+		if (k < lt) {
+			hi = lt - 1;
+		}
+		else if (k > gt) {
+			lo = gt + 1;
+		}
+		else {
+			return;
 		}
 	}
-	s[i] = p;
-	return m;
 }
 
-#ifdef EXACT_SELECTION
-/* a pair of points */
+/* Upper hull subproblems left to solve, or vertices to output */
 typedef struct {
-	point a, b;
-} point_pair;
+	count_t lo, hi;		/* range of s, hi < 0 to output vertex lo */
+	point a, b;			/* hull vertices on both sides of the range */
+} chan_task;
 
-#define slope_cmp(x, y) sign(area(x.a, x.b, x.
+/* Unbounded stack of chan_task */
+typedef struct {
+	chan_task *tasks;
+	count_t count, capacity;
+} chan_stack;
 
-static int select_slope(point_pair *s, int n, int r)
+/* Returns false when out of memory */
+static bool chan_push(chan_stack *stack, count_t lo, count_t hi, point a, point b)
 {
-	int i, j, ret;
-	double dx, dy;
-	point tmp;
-	point_pair pivot;
-
-	i = rand() % n;
-	pivot = s[i];
-	for (i = 0, j = n; i < n; i++) {
-		dx = s[i].a.x - pivot.a.x;
-		dy = s[i].a.y - pivot.a.y;
-		tmp.x = s[i].b.x - dx;
-		tmp.y = s[i].b.y - dy;
-		ret = sign(area(pivot.a, pivot.b, tmp));
+	if (stack->count == stack->capacity) {
+		count_t capacity = stack->capacity ? 2 * stack->capacity : 64;
+		chan_task *tasks = (chan_task *)realloc(stack->tasks, capacity * sizeof(chan_task));
+		if (tasks == NULL) {
+			return false;
+		}
+		stack->tasks = tasks;
+		stack->capacity = capacity;
 	}
-	return 0;
+	stack->tasks[stack->count].lo = lo;
+	stack->tasks[stack->count].hi = hi;
+	stack->tasks[stack->count].a = a;
+	stack->tasks[stack->count].b = b;
+	stack->count++;
+	return true;
 }
-#endif /*EXACT_SELECTION*/
 
-/* Compute the upper hull of the point set s.
- */
-static int chan_compute_hull(point *s, int n, int dir)
+/* Unbounded list of the indexes in s of the hull vertices, grown as
+ * chan_stack: O(h) memory */
+typedef struct {
+	count_t *indexes;
+	count_t count, capacity;
+} chan_vertices;
+
+/* Returns false when out of memory */
+static bool chan_add_vertex(chan_vertices *vertices, count_t index)
 {
-	point a, b, c, max, tmp;
-	double dx, dy, ar;
-	int maxi = 0, m, ri, g, i, j, k, l, im, jm, km, ret, p1, p2,
-		x, y, z, r[3], eof[3];
-	point stack[50];
+	if (vertices->count == vertices->capacity) {
+		count_t capacity = vertices->capacity ? 2 * vertices->capacity : 64;
+		count_t *indexes = (count_t *)realloc(vertices->indexes, capacity * sizeof(count_t));
+		if (indexes == NULL) {
+			return false;
+		}
+		vertices->indexes = indexes;
+		vertices->capacity = capacity;
+	}
+	vertices->indexes[vertices->count++] = index;
+	return true;
+}
 
+static int compare_indexes(const void *a, const void *b)
+{
+	count_t x = *(const count_t *)a, y = *(const count_t *)b;
+	return (x > y) - (x < y);
+}
 
-	/* for small cases, use heaphull algorithm */
-	if (n < 10) {
-		return heap_upperlower_hull(s, n, dir);
-	}
+/* Compute the upper hull vertices strictly between the vertices a and b
+ * from the points of s[lo..hi), all between a and b.  Points not strictly
+ * above ab are dropped, the others are paired and the extreme point max
+ * in the direction orthogonal to the median slope of the pairs is a hull
+ * vertex.  Left of max, a pair with a slope not greater than the median
+ * can't have its right point on the hull; right of max, a pair with a
+ * slope not smaller than the median can't have its left point on the
+ * hull: a quarter of the points are pruned.  The points left and right
+ * of max are then two subproblems.  Vertices are output from left to
+ * right by index in s (their location doesn't change afterwards).
+ * Returns false when out of memory.
+ */
+static bool chan_solve(point *s, chan_stack *stack, chan_vertices *hull, uint64_t *random)
+{
+	count_t lo, hi, end, i, w, m, maxi, left, right;
+	point a, b, pa, pb, max, tmp;
+	double ar, armax;
+
+	while (stack->count > 0) {
+		stack->count--;
+		lo = stack->tasks[stack->count].lo;
+		hi = stack->tasks[stack->count].hi;
+		a = stack->tasks[stack->count].a;
+		b = stack->tasks[stack->count].b;
+
+		if (hi < 0) {
+			if (!chan_add_vertex(hull, lo)) {
+				return false;
+			}
+			continue;
+		}
 
-	/* arrange points into pairs with their left endpoint first */
-	for (i = 0; i < n / 2; i++) {
-		if (dir*cmp(s[2 * i], s[2 * i + 1]) > 0) {
-			swap(s[2 * i], s[2 * i + 1], tmp);
+		/* keep the points strictly above ab */
+		end = lo;
+		for (i = lo; i < hi; i++) {
+			if (left_turn(a, b, s[i])) {
+				swap(s[i], s[end], tmp);
+				end++;
+			}
 		}
-	}
 
-	/* choose a random slope and find the extreme point in the direction
-	 * orthogonal to this slope */
-	ri = (rand() % (n / 2)) * 2;
-	dx = s[ri + 1].x - s[ri].x;
-	dy = s[ri + 1].y - s[ri].y;
-	maxi = 0;
-	c.x = s[maxi].x + dx;
-	c.y = s[maxi].y + dy;
-	for (i = 1; i < n; i++) {
-		ar = area(s[maxi], c, s[i]);
-		if (ar > 0 || (ar == 0 && dir * cmp(s[i], s[maxi]) >= 0)) {
-			maxi = i;
-			c.x = s[maxi].x + dx;
-			c.y = s[maxi].y + dy;
+		/* pair the points, left endpoint first, copies are dropped */
+		i = lo;
+		while (i + 1 < end) {
+			if (cmp(s[i], s[i + 1]) == 0) {
+				end--;
+				swap(s[i + 1], s[end], tmp);
+			}
+			else {
+				if (cmp(s[i], s[i + 1]) > 0) {
+					swap(s[i], s[i + 1], tmp);
+				}
+				i += 2;
+			}
 		}
-	}
-	max = s[maxi];
-
-	/* compute subproblem sizes */
-	p1 = p2 = 0;
-	/* check left endpoints of pairs */
-	for (i = 0; i < n; i += 2) {
-		ret = dir * cmp(s[i], s[maxi]);
-		if (ret == 0) {
-			p1++;
+
+		if (end - lo <= 1) {
+			if (end > lo && !chan_add_vertex(hull, lo)) {
+				return false;
+			}
+			continue;
 		}
-		else if (ret < 0) {
-			p2++;
+
+		/* median slope and extreme point in its orthogonal direction */
+		m = (end - lo) / 2;
+		select_slope(s + lo, m, m / 2, random);
+		pa = s[lo + 2 * (m / 2)];
+		pb = s[lo + 2 * (m / 2) + 1];
+
+		maxi = lo;
+		armax = area(pa, pb, s[lo]);
+		for (i = lo + 1; i < end; i++) {
+			ar = area(pa, pb, s[i]);
+			if (ar > armax || (ar == armax && cmp(s[i], s[maxi]) > 0)) {
+				maxi = i;
+				armax = ar;
+			}
 		}
-		else if (i == n - 1 || left_turn(s[maxi], s[i + 1], s[i])) {
-			p1++;
+		/* a or b can be further: the points of the range on that
+		 * line are then not all hull vertices, max is a or b and
+		 * the subproblem is only pruned */
+		if (area(pa, pb, b) >= armax) {
+			max = b;
 		}
-	}
-	/* check right endpoints of pairs */
-	for (i = 1; i < n; i += 2) {
-		ret = dir * cmp(s[i], s[maxi]);
-		if (ret >= 0) {
-			p1++;
+		else if (area(pa, pb, a) > armax) {
+			max = a;
 		}
-		else if (left_turn(s[i - 1], s[maxi], s[i])) {
-			p2++;
+		else {
+			max = s[maxi];
 		}
-	}
-	/* sanity check */
-	assert(p1 != 0);
 
-	/* Start shuffling into three subproblems */
-	if (n % 2 == 1) {
-		tmp = s[n - 1];     /* save this for later */
-	}
-	i = 0;
-	r[0] = i;
-	j = n - (p1 + p2);
-	im = j;
-	x = j / 2 * 2;
-	r[1] = x;
-	eof[0] = x;
-	k = (n - p2);
-	jm = k;
-	y = k / 2 * 2;
-	r[2] = y;
-	eof[1] = y;
-	z = n / 2 * 2;
-	km = n;
-	eof[2] = z;
-
-	p1 = 0;
-	p2 = 0;
-	m = 0;
-	/* set up the stack */
-	for (l = 0; l < 3; l++) {
-		assert(r[l] % 2 == 0);
-		if (r[l] != eof[l]) {
-			stack[2 * m] = s[r[l]++];
-			stack[2 * m + 1] = s[r[l]++];
-			assert(dir * cmp(stack[2 * m], stack[2 * m + 1]) <= 0);
-			m++;
-		}
-	}
-	while (m > 0 || r[0] != eof[0] || r[1] != eof[1] || r[2] != eof[2]) {
-		if (m == 0) {
-			/* stack has become empty, read from one of our streams */
-			for (l = 0; l < 3; l++) {
-				assert(r[l] % 2 == 0);
-				if (r[l] != eof[l]) {
-					stack[2 * m] = s[r[l]++];
-					stack[2 * m + 1] = s[r[l]++];
-					assert(dir * cmp(stack[2 * m], stack[2 * m + 1]) <= 0);
-					break;
-				}
+		/* prune, kept points are moved to the front */
+		w = lo;
+		for (i = lo; i + 1 < end; i += 2) {
+			bool keepLeft = true, keepRight = true;
+			if (cmp(s[i + 1], max) < 0 && slope_cmp(s[i], s[i + 1], pa, pb) <= 0) {
+				keepRight = false;
+			}
+			else if (cmp(s[i], max) > 0 && slope_cmp(s[i], s[i + 1], pa, pb) >= 0) {
+				keepLeft = false;
+			}
+			if (keepLeft) {
+				swap(s[w], s[i], tmp);
+				w++;
+			}
+			if (keepRight) {
+				swap(s[w], s[i + 1], tmp);
+				w++;
 			}
-			m++;
-		}
-		/* pop a pair off the stack */
-		m--;
-		a = stack[2 * m];
-		b = stack[2 * m + 1];
-		assert(dir * cmp(a, b) <= 0);
-		/* place left endpoint */
-		ret = dir * cmp(a, max);
-		if (ret == 0) {
-			assert(j < jm);
-			m = place(a, s, j, r, eof, stack, m);
-			j++;
-			p1++;
-		}
-		else if (ret < 0) {
-			assert(k < km);
-			m = place(a, s, k, r, eof, stack, m);
-			k++;
-			p2++;
 		}
-		else if (left_turn(max, b, a)) {
-			assert(j < jm);
-			m = place(a, s, j, r, eof, stack, m);
-			j++;
-			p1++;
+		if ((end - lo) % 2 == 1) {
+			swap(s[w], s[end - 1], tmp);
+			w++;
 		}
-		else {
-			assert(i < im);
-			m = place(a, s, i, r, eof, stack, m);
-			i++;
+		if (cmp(max, a) == 0 || cmp(max, b) == 0) {
+			if (!chan_push(stack, lo, w, a, b)) {
+				return false;
+			}
+			continue;
 		}
-		/* place right endpoint */
-		ret = dir * cmp(b, max);
-		if (ret >= 0) {
-			assert(j < jm);
-			m = place(b, s, j, r, eof, stack, m);
-			j++;
-			p1++;
+
+		/* points left of max, then right of max, then copies of max */
+		left = lo;
+		right = w;
+		i = lo;
+		while (i < right) {
+			int ret = cmp(s[i], max);
+			if (ret < 0) {
+				swap(s[i], s[left], tmp);
+				left++;
+				i++;
+			}
+			else if (ret > 0) {
+				i++;
+			}
+			else {
+				right--;
+				swap(s[i], s[right], tmp);
+			}
 		}
-		else if (left_turn(a, max, b)) {
-			assert(k < km);
-			m = place(b, s, k, r, eof, stack, m);
-			k++;
-			p2++;
+
+		/* s[left..right) is right of max, s[right] is max: solved left
+		 * part first, then max, then the right part */
+		if (!chan_push(stack, left, right, max, b) || !chan_push(stack, right, -1, max, max)
+			|| !chan_push(stack, lo, left, a, max)) {
+			return false;
 		}
-		else {
-			assert(i < im);
-			m = place(b, s, i, r, eof, stack, m);
-			i++;
+	}
+	return true;
+}
+
+/* Compute the upper (dir = 1) or lower (dir = -1) hull of s.  The hull
+ * is stored in counterclockwise order beginning at s+(return value),
+ * as heap_upperlower_hull does.  O(n log h) with h the hull size, O(h)
+ * memory.  Out of memory, heap_upperlower_hull computes it.
+ */
+static count_t chan_compute_hull(point *s, count_t n, int dir)
+{
+	count_t i, l = 0, r = 0, h, w, j, *sorted;
+	point a, b, tmp, *pHull = NULL;
+	chan_stack stack = { NULL, 0, 0 };
+	chan_vertices hull = { NULL, 0, 0 };
+	uint64_t random = 88172645463325252ull;
+	bool isSolved;
+
+	if (n <= 0) {
+		return 0;
+	}
+
+	/* the lower hull is the upper hull of the points turned by half a turn */
+	if (dir < 0) {
+		for (i = 0; i < n; i++) {
+			s[i].x = -s[i].x;
+			s[i].y = -s[i].y;
 		}
-		assert(m < 4);
 	}
 
-	/* handle unmatched point */
-	if (n % 2 == 1) {
-		if (dir * cmp(tmp, max) < 0) {
-			assert(k < km);
-			s[k++] = tmp;
-			p2++;
+	for (i = 1; i < n; i++) {
+		if (cmp(s[i], s[l]) < 0) {
+			l = i;
 		}
-		else {
-			assert(j < jm);
-			s[j++] = tmp;
-			p1++;
+		if (cmp(s[i], s[r]) > 0) {
+			r = i;
 		}
 	}
+	swap(s[0], s[l], tmp);
+	if (r == 0) {
+		r = l;
+	}
+	a = s[0];
+	b = s[r];
 
-#ifdef DEBUG
-	/* sanity check */
-	assert(i == im);
-	assert(j == jm);
-	assert(k == km);
-	for (l = i; l < j; l++) {
-		assert(dir * cmp(s[l], max) >= 0);
+	isSolved = chan_add_vertex(&hull, 0);
+	if (isSolved && cmp(a, b) != 0) {
+		swap(s[1], s[r], tmp);
+		isSolved = chan_push(&stack, 1, -1, b, b) && chan_push(&stack, 2, n, a, b)
+			&& chan_solve(s, &stack, &hull, &random);
 	}
-	for (l = j; l < k; l++) {
-		assert(dir * cmp(s[l], max) < 0);
+	free(stack.tasks);
+
+	h = hull.count;
+	if (isSolved) {
+		pHull = (point *)malloc(h * (sizeof(point) + sizeof(count_t)));
 	}
-#endif /*DEBUG*/
-
-	/* recurse */
-	x = chan_compute_hull(s + i, j - i, dir);
-	m = j - i - x;
-	m -= 1;
-	x += i;
-
-#ifdef DEBUG
-	/* verify result */
-	assert(cmp(s[x+m], max) == 0);
-	for (l = 0; l < m-1; l++) {
-		assert(dir * cmp(s[x+l], s[x+l+1]) >= 0);
+	if (pHull == NULL) {
+		free(hull.indexes);
+		if (dir < 0) {
+			for (i = 0; i < n; i++) {
+				s[i].x = -s[i].x;
+				s[i].y = -s[i].y;
+			}
+		}
+		return (count_t)heap_upperlower_hull_64(s, n, dir);
 	}
-#endif /*DEBUG*/
 
-	y = chan_compute_hull(s + j - 1, k - j + 1, dir);
-	g = y;
-	y += j - 1;
-
-#ifdef DEBUG
-	/* verify result */
-	assert(cmp(s[y], max) == 0);
-	for (l = y; l < n-1; l++) {
-		assert(dir * cmp(s[l], s[l+1]) >= 0);
+	/* move the hull to the end of s, from b to a, the other points stay
+	 * in front of it */
+	sorted = (count_t *)(pHull + h);
+	for (i = 0; i < h; i++) {
+		pHull[i] = s[hull.indexes[i]];
+		sorted[i] = hull.indexes[i];
+	}
+	qsort(sorted, h, sizeof(count_t), compare_indexes);
+	for (i = 0, j = 0, w = 0; i < n; i++) {
+		if (j < h && sorted[j] == i) {
+			j++;
+		}
+		else {
+			s[w++] = s[i];
+		}
+	}
+	for (i = 0; i < h; i++) {
+		s[n - 1 - i] = pHull[i];
 	}
-#endif /*DEBUG*/
+	free(pHull);
+	free(hull.indexes);
 
-	while (m > 0) {
-		swap(s[x + m - 1], s[x + m + g - 1], tmp);
-		m--;
+	if (dir < 0) {
+		for (i = 0; i < n; i++) {
+			s[i].x = -s[i].x;
+			s[i].y = -s[i].y;
+		}
 	}
 
-	return x + g;
+	return n - h;
 }
 
 /* Compute the convex hull of the point set s.  The hull is stored at
  * location s+(return value) sorted in counterclockwise order
  */
-int chanhull(point *s, int n)
+int64_t chanhull_64(point *s, int64_t n)
 {
-	point tmp;
-	int i, j, k, g;
+	count_t i, l, u;
 
 	i = partition(s, n);
+	u = i + chan_compute_hull(s + i, n - i, 1);	/* upper hull */
+	l = chan_compute_hull(s, i, -1);			/* lower hull */
+	return join_hulls(s, l, i, u, n);
+}
 
-	k = chan_compute_hull(s + i, n - i, 1);
-	k += i;
-
-	/* bring leftmost endpoint to location k */
-	for (j = n - 1; j > k; j--) {
-		swap(s[j], s[j - 1], tmp);
-	}
+int chanhull(point *s, int n)
+{
+	return (int)chanhull_64(s, n);
+}
 
-	/* move discarded points to front of array */
-	g = k - i;
-	for (j = i - 1; j > 0; j--) {
-		swap(s[j], s[j + g], tmp);
+/* Same as chanhull, with parallel_partition and both halves of the hull
+ * computed on their own thread.
+ */
+int64_t chanhullParallel_64(point *s, int64_t n)
+{
+	count_t i, l, u;
+
+	i = parallel_partition(s, n);
+#pragma omp parallel sections
+	{
+#pragma omp section
+		u = i + chan_compute_hull(s + i, n - i, 1);	/* upper hull */
+#pragma omp section
+		l = chan_compute_hull(s, i, -1);			/* lower hull */
 	}
+	return join_hulls(s, l, i, u, n);
+}
 
-	j = chan_compute_hull(s + g, i + 2, -1);
-	j += g;
-
-	return j;
+int chanhullParallel(point *s, int n)
+{
+	return (int)chanhullParallel_64(s, n);
 }
 
 
 /* Compute the convex hull of the point set s.  The hull is stored at
 * location s+(return value) sorted in counterclockwise order
 */
+int64_t chanhullWithElapsedTime_64(point *s, int64_t n, double* elapsedTime)
+{
+	double startTime = omp_get_wtime();
+
+	int64_t count = chanhull_64(s, n);
+
+	*elapsedTime = omp_get_wtime() - startTime;
+
+	return count;
+}
+
 int chanhullWithElapsedTime(point *s, int n, double* elapsedTime)
+{
+	return (int)chanhullWithElapsedTime_64(s, n, elapsedTime);
+}
+
+
+/* Compute the convex hull of the point set s in parallel.  The hull is
+* stored at location s+(return value) sorted in counterclockwise order
+*/
+int64_t chanhullParallelWithElapsedTime_64(point *s, int64_t n, double* elapsedTime)
 {
 	double startTime = omp_get_wtime();
 
-	int count = chanhull(s, n);
+	int64_t count = chanhullParallel_64(s, n);
 
 	*elapsedTime = omp_get_wtime() - startTime;
 
 	return count;
 }
+
+int chanhullParallelWithElapsedTime(point *s, int n, double* elapsedTime)
+{
+	return (int)chanhullParallelWithElapsedTime_64(s, n, elapsedTime);
+}
\ No newline at end of file
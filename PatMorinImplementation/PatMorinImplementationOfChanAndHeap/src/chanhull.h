@@ -21,6 +21,18 @@ extern "C" {  // only need to export C interface if
 	DllExport int chanhull(point *s, int n);
 	DllExport int chanhullWithElapsedTime(point *s, int n, double* elapsedTime);
 
+	/* Same as above for arrays of more than 2^31 points */
+	DllExport int64_t chanhull_64(point *s, int64_t n);
+	DllExport int64_t chanhullWithElapsedTime_64(point *s, int64_t n, double* elapsedTime);
+
+	/* Same as chanhull, partition and both halves of the hull are done
+	* in parallel (OpenMP).
+	*/
+	DllExport int chanhullParallel(point *s, int n);
+	DllExport int chanhullParallelWithElapsedTime(point *s, int n, double* elapsedTime);
+	DllExport int64_t chanhullParallel_64(point *s, int64_t n);
+	DllExport int64_t chanhullParallelWithElapsedTime_64(point *s, int64_t n, double* elapsedTime);
+
 #ifdef __cplusplus
 }  // only need to export C interface if
 // used by C++ source code
@@ -4,6 +4,7 @@
  * Date: Sun Aug 19 16:15:58 EDT 2001
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 
 #include "heaphull.h"
@@ -28,9 +29,9 @@
  * value of dir should be 1 if s is a min-heap and -1 if s is a
  * max-heap.  
  */
-static void heapify(point *s, int n, int i, int dir)
+static void heapify(point *s, count_t n, count_t i, int dir)
 {
-  int min;
+  count_t min;
   bool done;
   point tmp;
 
@@ -55,9 +56,9 @@ static void heapify(point *s, int n, int i, int dir)
 /* Build a heap of size n on the array s.  The value of dir determines
  * whether this is a max (dir=-1) or min (dir=1) heap. 
  */
-static void build_heap(point *s, int n, int dir)
+static void build_heap(point *s, count_t n, int dir)
 {
-  int i;
+  count_t i;
   
   for (i = n/2; i >= 0; i--) {
     heapify(s, n, i, dir);
@@ -68,9 +69,9 @@ static void build_heap(point *s, int n, int dir)
  * candidates for the lower hull and one which contains all candidates
  * for the upper hull.  Returns the index where the second set begins.  
  */
-static int partition(point *s, int n)
+static count_t partition(point *s, count_t n)
 {
-  int i, l = 0, r = 0;
+  count_t i, l = 0, r = 0;
   point a, b, tmp;
 
   /* find the highest leftmost point and lowest rightmost point */
@@ -98,11 +99,141 @@ static int partition(point *s, int n)
   return n;
 }
 
+/* Below this many points, parallel_partition is the same as partition */
+#define PARALLEL_PARTITION_MIN 65536
+
+/* Same as partition, on one chunk of s per thread.  Each chunk is
+ * partitioned in place around the same line, then the upper hull
+ * candidates left in the first part of s are swapped with the lower
+ * hull candidates left in the second part, matched by rank.
+ */
+count_t parallel_partition(point *s, count_t n)
+{
+  int k, chunkCount = omp_get_max_threads();
+  count_t l = 0, r = 0, lowerCount = 0;
+  count_t *starts, *splits, *extremes, *upperRanks, *lowerRanks;
+  point a, b;
+
+  if (n < PARALLEL_PARTITION_MIN || chunkCount < 2) {
+    return partition(s, n);
+  }
+
+  /* starts (c + 1), splits (c), extremes (2c), upperRanks (c + 1) and
+   * lowerRanks (c + 1) */
+  starts = (count_t *)malloc((6 * chunkCount + 3) * sizeof(count_t));
+  if (starts == NULL) {
+    return partition(s, n);
+  }
+  splits = starts + chunkCount + 1;
+  extremes = splits + chunkCount;
+  upperRanks = extremes + 2 * chunkCount;
+  lowerRanks = upperRanks + chunkCount + 1;
+  for (k = 0; k <= chunkCount; k++) {
+    starts[k] = n * k / chunkCount;
+  }
+
+  /* find the highest leftmost point and lowest rightmost point */
+#pragma omp parallel for schedule(static, 1)
+  for (k = 0; k < chunkCount; k++) {
+    count_t i, cl = starts[k], cr = starts[k];
+    for (i = starts[k] + 1; i < starts[k + 1]; i++) {
+      if (cmp(s[i], s[cl]) < 0) {
+        cl = i;
+      }
+      if (cmp(s[i], s[cr]) > 0) {
+        cr = i;
+      }
+    }
+    extremes[2 * k] = cl;
+    extremes[2 * k + 1] = cr;
+  }
+  for (k = 0; k < chunkCount; k++) {
+    if (cmp(s[extremes[2 * k]], s[l]) < 0) {
+      l = extremes[2 * k];
+    }
+    if (cmp(s[extremes[2 * k + 1]], s[r]) > 0) {
+      r = extremes[2 * k + 1];
+    }
+  }
+  a = s[l];
+  b = s[r];
+
+  /* partition each chunk */
+#pragma omp parallel for schedule(static, 1)
+  for (k = 0; k < chunkCount; k++) {
+    count_t i = starts[k], end = starts[k + 1];
+    point tmp;
+    while (i < end) {
+      if (right_turn(a, b, s[i])) {
+        i++;
+      } else {
+        end--;
+        swap(s[i], s[end], tmp);
+      }
+    }
+    splits[k] = end;
+  }
+  for (k = 0; k < chunkCount; k++) {
+    lowerCount += splits[k] - starts[k];
+  }
+
+  /* misplaced points: upper candidates before lowerCount, lower
+   * candidates after it.  Both counts are the same. */
+  upperRanks[0] = lowerRanks[0] = 0;
+  for (k = 0; k < chunkCount; k++) {
+    count_t end = starts[k + 1] < lowerCount ? starts[k + 1] : lowerCount;
+    count_t start = starts[k] > lowerCount ? starts[k] : lowerCount;
+    upperRanks[k + 1] = upperRanks[k] + (end > splits[k] ? end - splits[k] : 0);
+    lowerRanks[k + 1] = lowerRanks[k] + (splits[k] > start ? splits[k] - start : 0);
+  }
+
+#pragma omp parallel for schedule(static, 1)
+  for (k = 0; k < chunkCount; k++) {
+    count_t rank, i, j = 0;
+    point tmp;
+    for (rank = upperRanks[k]; rank < upperRanks[k + 1]; rank++) {
+      while (lowerRanks[j + 1] <= rank) {
+        j++;
+      }
+      i = splits[k] + rank - upperRanks[k];
+      swap(s[i], s[(starts[j] > lowerCount ? starts[j] : lowerCount) + rank - lowerRanks[j]], tmp);
+    }
+  }
+
+  free(starts);
+  return lowerCount;
+}
+
+/* Join the lower hull of the lower hull candidates, stored from left to
+ * right at s+l up to s+i, to the upper hull stored at s+u up to s+n
+ * (from the rightmost point b to the leftmost point a).  The lower hull
+ * is made convex again with a and b while it is moved just before s+u.
+ * Returns the location of the convex hull, stored in counterclockwise
+ * order.
+ */
+count_t join_hulls(point *s, count_t l, count_t i, count_t u, count_t n)
+{
+  count_t top = u, j;
+  point tmp, a = s[n-1];
+
+  for (j = i - 1; j >= l; j--) {
+    while (top < u && !left_turn(s[j], s[top], s[top+1])) {
+      top++;
+    }
+    top--;
+    swap(s[top], s[j], tmp);
+  }
+  while (top < u && !left_turn(a, s[top], s[top+1])) {
+    top++;
+  }
+  return top;
+}
+
 /* Construct the upper (dir = 1) or lower (dir = -1) hull of s and
  * store it beginning at s+tos and working backwards.  The value h
  * represents the number of points already stored at s+tos.
  */
-static int heap_compute_hull(point *s, int n, int tos, int h, int dir)
+static count_t heap_compute_hull(point *s, count_t n, count_t tos, count_t h, int dir)
 {
   point tmp;
 
@@ -126,9 +257,9 @@ static int heap_compute_hull(point *s, int n, int tos, int h, int dir)
 /* Compute the convex hull of hte point set s.  The hull is stored at 
  * location s+(return value) sorted in counterclockwise order
  */
-int heaphull2(point *s, int n)
+int64_t heaphull2_64(point *s, int64_t n)
 {
-  int i, j;
+  count_t i, j;
 
   i = partition(s, n);
   j = heap_compute_hull(s+i, n-i, n-i, 0, 1);     /* construct upper hull */
@@ -140,22 +271,76 @@ int heaphull2(point *s, int n)
   return i;
 }
 
+int heaphull2(point *s, int n)
+{
+  return (int)heaphull2_64(s, n);
+}
+
+/* Same as heaphull2, with parallel_partition and both halves of the
+ * hull computed on their own thread.
+ */
+int64_t heaphull2Parallel_64(point *s, int64_t n)
+{
+  count_t i, l, u;
+
+  i = parallel_partition(s, n);
+#pragma omp parallel sections
+  {
+#pragma omp section
+    u = i + heap_compute_hull(s+i, n-i, n-i, 0, 1);     /* upper hull */
+#pragma omp section
+    l = heap_compute_hull(s, i, i, 0, -1);              /* lower hull */
+  }
+  return join_hulls(s, l, i, u, n);
+}
+
+int heaphull2Parallel(point *s, int n)
+{
+  return (int)heaphull2Parallel_64(s, n);
+}
+
 /* Compute the upper (dir = 1) or lower (dir = -1) hull of the point
  * set s.  The hull is stored in counterclockwise order beginning at
  * s+(return value). 
  */
-int heap_upperlower_hull(point *s, int n, int dir)
+int64_t heap_upperlower_hull_64(point *s, int64_t n, int dir)
 {
   return heap_compute_hull(s, n, n, 0, dir);
 }
 
+int heap_upperlower_hull(point *s, int n, int dir)
+{
+  return (int)heap_upperlower_hull_64(s, n, dir);
+}
+
+int64_t heaphull2WithElapsedTime_64(point *s, int64_t n, double* elapsedTime)
+{
+	double startTime = omp_get_wtime();
+
+	int64_t count = heaphull2_64(s, n);
+
+	*elapsedTime = omp_get_wtime() - startTime;
+
+	return count;
+}
+
 int heaphull2WithElapsedTime(point *s, int n, double* elapsedTime)
+{
+	return (int)heaphull2WithElapsedTime_64(s, n, elapsedTime);
+}
+
+int64_t heaphull2ParallelWithElapsedTime_64(point *s, int64_t n, double* elapsedTime)
 {
 	double startTime = omp_get_wtime();
 
-	int count = heaphull2(s, n);
+	int64_t count = heaphull2Parallel_64(s, n);
 
 	*elapsedTime = omp_get_wtime() - startTime;
 
 	return count;
+}
+
+int heaphull2ParallelWithElapsedTime(point *s, int n, double* elapsedTime)
+{
+	return (int)heaphull2ParallelWithElapsedTime_64(s, n, elapsedTime);
 }
\ No newline at end of file
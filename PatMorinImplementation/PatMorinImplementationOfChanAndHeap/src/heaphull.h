@@ -23,14 +23,34 @@ extern "C" {  // only need to export C interface if
 	*/
 
 	DllExport int heap_upperlower_hull(point *s, int n, int dir);
+	DllExport int64_t heap_upperlower_hull_64(point *s, int64_t n, int dir);
 	
 	/* Compute the convex hull of the point set s.  The hull is stored at 
 	* location s+(return value) sorted in counterclockwise order
 	*/
 
 	DllExport int heaphull2(point *s, int n);
+	DllExport int64_t heaphull2_64(point *s, int64_t n);
 
 	DllExport int heaphull2WithElapsedTime(point *s, int n, double* elapsedTime);
+	DllExport int64_t heaphull2WithElapsedTime_64(point *s, int64_t n, double* elapsedTime);
+
+	/* Same as heaphull2, partition and both halves of the hull are done
+	* in parallel (OpenMP).
+	*/
+
+	DllExport int heaphull2Parallel(point *s, int n);
+	DllExport int64_t heaphull2Parallel_64(point *s, int64_t n);
+
+	DllExport int heaphull2ParallelWithElapsedTime(point *s, int n, double* elapsedTime);
+	DllExport int64_t heaphull2ParallelWithElapsedTime_64(point *s, int64_t n, double* elapsedTime);
+
+	/* Shared with chanhull.c: parallel partition of s in lower hull and
+	* upper hull candidates, and join of both halves of the hull.
+	*/
+
+	count_t parallel_partition(point *s, count_t n);
+	count_t join_hulls(point *s, count_t l, count_t i, count_t u, count_t n);
 	
 #ifdef __cplusplus
 }  // only need to export C interface if
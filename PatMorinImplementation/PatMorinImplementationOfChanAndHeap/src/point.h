@@ -6,9 +6,15 @@
 #ifndef __POINT_H
 #define __POINT_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 /* A number type */
 typedef double number;
 
+/* A count/index type, as wide as the address space (64 bits on x64) */
+typedef ptrdiff_t count_t;
+
 /* A 2-d point type */
 typedef struct {
   number x; 
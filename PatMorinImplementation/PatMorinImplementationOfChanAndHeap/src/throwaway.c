@@ -18,10 +18,11 @@
 * stored at the beginning of s.  The return value is the number of
 * points eliminated.  
 */
-int throwaway_heuristic(point *s, int n)
+int64_t throwaway_heuristic_64(point *s, int64_t n)
 {
-	int i, j, elim = 0, k;
-	int maxi[8];
+	count_t i, elim = 0;
+	int j, k;
+	count_t maxi[8];
 	double proj, maxs[8];
 	double signs[8][2] = { {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0},
 	{-1, -1}, {0, -1}, {1, -1} };
@@ -53,7 +54,7 @@ int throwaway_heuristic(point *s, int n)
 	i = 0;
 	while (i < n) {    
 		for (j = 0; j < k; j++) {
-			if (right_turn(hull8[j], hull8[(j+1)%8], s[i])
+			if (right_turn(hull8[j], hull8[(j+1)%k], s[i])
 				|| cmp(hull8[j], s[i]) == 0) {
 					break;
 			}
@@ -72,4 +73,9 @@ int throwaway_heuristic(point *s, int n)
 	return 0;
 }
 
+int throwaway_heuristic(point *s, int n)
+{
+	return (int)throwaway_heuristic_64(s, n);
+}
+
 
@@ -17,6 +17,7 @@ extern "C" {  // only need to export C interface if
 	// used by C++ source code
 #endif
 	DllExport int throwaway_heuristic(point *s, int n);
+	DllExport int64_t throwaway_heuristic_64(point *s, int64_t n);
 #ifdef __cplusplus
 }  // only need to export C interface if
 // used by C++ source code